@@ -59,7 +59,7 @@ namespace Mezzanine
             try{
                 Unit.FilesRaw.reserve(Unit.Filenames.size());
             }catch (std::exception&){
-                while(Unit.Status!=AtomicCompareAndSwap32(&(Unit.Status), Unit.Status, Failed));
+                Unit.CompleteAsynchronousWork(Failed);
                 return;
             }
             for(std::vector<String>::iterator CurrentFileName = Unit.Filenames.begin(); CurrentFileName!=Unit.Filenames.end(); CurrentFileName++)
@@ -74,24 +74,23 @@ namespace Mezzanine
                     try{
                         Loading = new RawFile(FileLength);
                     }catch (std::exception&){
-                        while(Unit.Status!=AtomicCompareAndSwap32(&(Unit.Status), Unit.Status, Failed));
+                        Unit.CompleteAsynchronousWork(Failed);
                         return;
                     }
 
                     File.read((char*)Loading->Data, FileLength);
                     Unit.FilesRaw.push_back(Loading);
                 }else{
-                    while(Unit.Status!=AtomicCompareAndSwap32(&(Unit.Status), Unit.Status, Failed));
-                    break;
+                    Unit.CompleteAsynchronousWork(Failed);
+                    return;
                 }
 
             }
-            while(Unit.Status!=AtomicCompareAndSwap32(&(Unit.Status), Unit.Status, Complete));
+            Unit.CompleteAsynchronousWork(Complete);
         }
 
         AsynchronousFileLoadWorkUnit::AsynchronousFileLoadWorkUnit() :
-            LoadingThread(0),
-            Status(NotStarted)
+            LoadingThread(0)
         {}
 
         AsynchronousFileLoadWorkUnit::~AsynchronousFileLoadWorkUnit()
@@ -99,22 +98,27 @@ namespace Mezzanine
 
         RunningState AsynchronousFileLoadWorkUnit::BeginLoading(const std::vector<String>& Filenames_)
         {
-            if(Running!=AtomicCompareAndSwap32(&Status, Status, Running))
+            if(BeginAsynchronousWork())
             {
                 //DeleteLoadedFiles();
+                if(LoadingThread) // Finished, but no frame ran this to clean it up
+                {
+                    LoadingThread->join();
+                    delete LoadingThread;
+                }
                 FilesRaw.clear();
                 Filenames = Filenames_;
                 LoadingThread = new Thread(ThreadLoading, this);
                 return Starting;
             }else{
                 //throw?
-                return (RunningState)Status;
+                return IsWorkDone();
             }
         }
 
         void AsynchronousFileLoadWorkUnit::DoWork(DefaultThreadSpecificStorage::Type &)
         {
-            if(Complete==Status&&0!=LoadingThread)
+            if(Running!=IsWorkDone()&&0!=LoadingThread)
             {
                 LoadingThread->join();
                 delete LoadingThread;
@@ -123,7 +127,7 @@ namespace Mezzanine
         }
 
         RunningState AsynchronousFileLoadWorkUnit::IsWorkDone()
-            { return (RunningState)Status; }
+            { return iAsynchronousWorkUnit::IsWorkDone(); }
 
         RawFile* AsynchronousFileLoadWorkUnit::GetFile(const String& FileName) const
         {
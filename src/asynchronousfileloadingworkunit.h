@@ -120,9 +120,6 @@ namespace Mezzanine
                 /// @brief This is either 0 or the other thread that is loading.
                 Thread* LoadingThread;
 
-                /// @brief This stores the current RunningState.
-                Int32 Status;
-
             public:
                 /// @brief Default constructor.
                 AsynchronousFileLoadWorkUnit();
@@ -149,6 +146,8 @@ namespace Mezzanine
                 RunningState BeginLoading(const std::vector<String>& Filenames_);
 
                 /// @brief This checks if Asynchronous loading thread has completed and if so it cleans up that threads' resources.
+                /// @details In a frame, dependents of this are released as soon as the loading thread finishes, see
+                /// @ref iAsynchronousWorkUnit.
                 virtual void DoWork(DefaultThreadSpecificStorage::Type&);
 
                 /// @brief Get the @ref RunningState of the file loading
@@ -159,6 +158,7 @@ namespace Mezzanine
                 ///     - @ref Complete "Complete" - The loading thread has completed its work, and new loading can definitely begin after the next call to @ref DoWork method.
                 ///     - @ref Failed "Failed" - If somekind of recoverable error occured, this will be returned, there are no guarantees about the state of the loaded files.
                 /// @return The running state as of the time of this call, though it is subject to immediate thread unsafe change.
+                /// Use @ref WaitForAsynchronousWork to block until loading is done instead of checking this repeatedly.
                 virtual RunningState IsWorkDone();
 
                 /// @brief Get a loaded @ref RawFile in linear time.
@@ -42,15 +42,99 @@
 #define _asynchronousworkunit_cpp
 
 #include "asynchronousworkunit.h"
+#include "atomicoperations.h"
+#include "framescheduler.h"
+#include "resumableworkunit.h"
+#include "systemcalls.h"
 
 /// @file
-/// @brief Contains very little actually.
+/// @brief The completion handoff shared by every asynchronous WorkUnit.
 
 namespace Mezzanine
 {
     namespace Threading
     {
+        iAsynchronousWorkUnit::iAsynchronousWorkUnit() :
+            AsynchronousStatus(NotStarted),
+            CompletionScheduler(0)
+            {}
 
+        iAsynchronousWorkUnit::~iAsynchronousWorkUnit()
+            {}
+
+        bool iAsynchronousWorkUnit::BeginAsynchronousWork()
+        {
+            for(Int32 Current = AtomicAdd(&AsynchronousStatus,0); Running!=Current; Current = AtomicAdd(&AsynchronousStatus,0))
+            {
+                if(Current==AtomicCompareAndSwap32(&AsynchronousStatus,Current,Running))
+                    { return true; }
+            }
+            return false;
+        }
+
+        RunningState iAsynchronousWorkUnit::IsWorkDone()
+            { return RunningState(AtomicAdd(&AsynchronousStatus,0)); }
+
+        void iAsynchronousWorkUnit::CompleteAsynchronousWork(RunningState Result)
+        {
+            AtomicCompareAndSwap32(&AsynchronousStatus,Running,Result);
+            AtomicWakeAll(&AsynchronousStatus);
+
+            WaitersLock.Lock(); // Anything registering after this sees the new status instead
+            std::vector<ResumableWorkUnit*> Resume;
+            Resume.swap(Waiters);
+            WaitersLock.Unlock();
+            for(std::vector<ResumableWorkUnit*>::iterator Iter = Resume.begin(); Iter!=Resume.end(); ++Iter)
+                { (*Iter)->Wake(); }
+
+            FrameScheduler* Scheduler = CompletionScheduler;
+            if(Scheduler && Scheduler->FinishAsynchronousWorkUnit(this)) // Still in the frame that deferred this
+            {
+                CurrentRunningState = TagRunningState(Complete);
+                Scheduler->ReleaseDependentsOf(this);
+            }
+        }
+
+        RunningState iAsynchronousWorkUnit::WaitForAsynchronousWork()
+        {
+            while(Running==AtomicAdd(&AsynchronousStatus,0))
+                { AtomicWait(&AsynchronousStatus,Running); }
+            return IsWorkDone();
+        }
+
+        bool iAsynchronousWorkUnit::ResumeWhenComplete(ResumableWorkUnit* Waiter)
+        {
+            WaitersLock.Lock();
+            bool Waiting = Running==IsWorkDone();
+            if(Waiting)
+                { Waiters.push_back(Waiter); }
+            WaitersLock.Unlock();
+            return Waiting;
+        }
+
+        void iAsynchronousWorkUnit::operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            MaxInt Begin = Mezzanine::GetTimeStamp();
+
+            std::ostream& Out = CurrentThreadStorage.GetUsableLogger();
+            Out << "<WorkUnit id=\"" << std::hex << this << std::dec << "\">" << std::endl;
+
+            this->DoWork(CurrentThreadStorage);
+            MaxInt End = Mezzanine::GetTimeStamp();
+            this->GetPerformanceLog().Insert( Whole(End-Begin));
+
+            CompletionScheduler = CurrentThreadStorage.GetFrameScheduler();
+            if(CompletionScheduler && Running==IsWorkDone() && CompletionScheduler->DeferAsynchronousWorkUnit(this))
+            {
+                Out << "<AsynchronousWorkPending />" << std::endl << "</WorkUnit>" << std::endl;
+                return; // CompleteAsynchronousWork finishes this if the frame is still running, or it runs again next frame
+            }
+            CurrentRunningState = TagRunningState(Complete);
+
+            if(CompletionScheduler)
+                { CompletionScheduler->ReleaseDependentsOf(this, &CurrentThreadStorage); }
+            Out << "</WorkUnit>" << std::endl;
+        }
     } // \Threading
 } // \Mezzanine
 #endif
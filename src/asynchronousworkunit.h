@@ -45,6 +45,7 @@
 
 #if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
 #include "doublebufferedresource.h"
+#include "spinlock.h"
 #include "workunit.h"
 #endif
 
@@ -55,13 +56,66 @@ namespace Mezzanine
 {
     namespace Threading
     {
+        class ResumableWorkUnit;
+
         /// @brief The interface for a WorkUnit that will keep running when the rest of the scheduler is paused.
+        /// @details Derived classes call @ref BeginAsynchronousWork before handing work to another thread, a device or the
+        /// operating system, and whatever finishes that work calls @ref CompleteAsynchronousWork from any thread. Nothing
+        /// needs to poll.
+        /// @n @n
+        /// When this runs in a frame while its asynchronous work is still going, it stays @ref Running "Running" after
+        /// @ref DoWork returns instead of completing, and neither it nor anything depending on it holds up the frame. If the
+        /// asynchronous work completes before the frame ends, its dependents are released right away and any parked threads
+        /// are woken to run them. Otherwise this runs again next frame, completing if the work is done by then or staying
+        /// pending another frame if not, so DoWork must not start more asynchronous work while it is still running.
         class MEZZ_LIB iAsynchronousWorkUnit : public DefaultWorkUnit
         {
+            protected:
+                /// @brief The @ref RunningState of the asynchronous work, changed atomically and waited on as a futex.
+                Int32 AsynchronousStatus;
+
+                /// @brief The scheduler this last ran in, which finishes it if the asynchronous work completes in the same frame.
+                FrameScheduler* CompletionScheduler;
+
+                /// @brief Suspended WorkUnits to wake when the asynchronous work completes.
+                std::vector<ResumableWorkUnit*> Waiters;
+
+                /// @brief Protects Waiters.
+                SpinLock WaitersLock;
+
+                /// @brief Mark the asynchronous work as started, call this before starting it.
+                /// @return False if asynchronous work was already running, in which case none should be started.
+                bool BeginAsynchronousWork();
+
             public:
+                /// @brief Constructor
+                iAsynchronousWorkUnit();
+
+                /// @brief Virtual Deconstructor
+                virtual ~iAsynchronousWorkUnit();
+
                 /// @brief This will atomically allow any thread to check if this WorkUnit has completed its work.
                 /// @return This returns a @ref RunningState indicating the current status of the asynchronous work.
-                virtual RunningState IsWorkDone() = 0;
+                virtual RunningState IsWorkDone();
+
+                /// @brief Called from any thread when the asynchronous work is done.
+                /// @details This wakes anything in @ref WaitForAsynchronousWork and, if this ran in the frame still running,
+                /// completes this WorkUnit and releases its dependents right away.
+                /// @param Result @ref Complete "Complete" or @ref Failed "Failed", either way dependents are released.
+                void CompleteAsynchronousWork(RunningState Result = Complete);
+
+                /// @brief Block the calling thread until the asynchronous work is no longer running.
+                /// @return The @ref RunningState it finished with.
+                RunningState WaitForAsynchronousWork();
+
+                /// @brief Wake a suspended @ref ResumableWorkUnit when the asynchronous work completes, instead of blocking a thread.
+                /// @param Waiter The WorkUnit to wake, see @ref ResumableWorkUnit::AwaitAsynchronousWork.
+                /// @return False if the asynchronous work was not running, in which case nothing will wake Waiter.
+                bool ResumeWhenComplete(ResumableWorkUnit* Waiter);
+
+                /// @brief Do the work and complete, unless asynchronous work is still running.
+                /// @param CurrentThreadStorage The resources of the thread running this.
+                virtual void operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage);
         };//iAsynchronousWorkUnit
 
     } // \Threading
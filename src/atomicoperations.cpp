@@ -81,6 +81,68 @@ namespace Mezzanine
                 return __sync_fetch_and_add(VariableToChange,Value);
             #endif
         }
+
+        Int32 AtomicLoad(const Int32* VariableToRead)
+        {
+            #ifdef _MEZZ_THREAD_WIN32_
+                return *((const volatile long*)VariableToRead); // Volatile reads are acquire loads in MSVC
+            #elif defined(__ATOMIC_ACQUIRE)
+                return __atomic_load_n(VariableToRead, __ATOMIC_ACQUIRE);
+            #else
+                Int32 Value = *((const volatile Int32*)VariableToRead);
+                __sync_synchronize();
+                return Value;
+            #endif
+        }
+
+        void SpinPause()
+        {
+            #ifdef _MEZZ_THREAD_WIN32_
+                YieldProcessor();
+            #elif defined(__i386__) || defined(__x86_64__)
+                __builtin_ia32_pause();
+            #elif defined(__arm__) || defined(__aarch64__)
+                __asm__ __volatile__("yield");
+            #endif
+        }
+
+        void AtomicWait(Int32* VariableToWatch, const Int32& ExpectedValue)
+        {
+            #ifdef __linux__
+                syscall(SYS_futex, VariableToWatch, FUTEX_WAIT_PRIVATE, ExpectedValue, 0, 0, 0);
+            #else
+                if(ExpectedValue==AtomicAdd(VariableToWatch,0))
+                {
+                    #ifdef _MEZZ_THREAD_WIN32_
+                        Sleep(0);
+                    #else
+                        sched_yield();
+                    #endif
+                }
+            #endif
+        }
+
+        void AtomicWaitFor(Int32* VariableToWatch, const Int32& ExpectedValue, const Whole& Microseconds)
+        {
+            #ifdef __linux__
+                struct timespec Timeout;
+                Timeout.tv_sec = Microseconds/1000000;
+                Timeout.tv_nsec = long(Microseconds%1000000)*1000;
+                syscall(SYS_futex, VariableToWatch, FUTEX_WAIT_PRIVATE, ExpectedValue, &Timeout, 0, 0);
+            #else
+                (void)Microseconds; // AtomicWait never sleeps for long here
+                AtomicWait(VariableToWatch,ExpectedValue);
+            #endif
+        }
+
+        void AtomicWakeAll(Int32* VariableToWatch)
+        {
+            #ifdef __linux__
+                syscall(SYS_futex, VariableToWatch, FUTEX_WAKE_PRIVATE, 0x7fffffff, 0, 0, 0);
+            #else
+                (void)VariableToWatch; // Nothing sleeps for long in AtomicWait here
+            #endif
+        }
     }//Threading
 }//Mezzanine
 
@@ -82,6 +82,40 @@ namespace Mezzanine
         /// @note This very specific semantics of this function are useless in most scripting so it is not included in Lua and other scripting languages.
         /// @return The value just before being incremented. This is not always *VariableToChange. If another thread attempted an atomic operation on this at the same time the result could be an unexpected value.
         Int32 MEZZ_LIB AtomicAdd(Int32* VariableToChange, Int32 Value);
+
+        /// @brief Read a value another thread may be changing, without locking the bus like @ref AtomicAdd does.
+        /// @details This is an acquire load, so nothing this thread reads after it can see older values than it did. Use
+        /// this to poll in a spin loop, and keep read-modify-write operations for changing the value.
+        /// @param VariableToRead A pointer to the 32 bit integer to read.
+        /// @return The value read.
+        Int32 MEZZ_LIB AtomicLoad(const Int32* VariableToRead);
+
+        /// @brief Tell the processor the calling thread is spinning, call this each time through a spin loop.
+        /// @details On x86 this is the pause instruction and on ARM the yield instruction. They keep a spinning thread from
+        /// starving the other hyperthread on its core and from flooding the pipeline with reads. Elsewhere this does nothing.
+        void MEZZ_LIB SpinPause();
+
+        /// @brief Put the calling thread to sleep while a value is unchanged.
+        /// @details If *VariableToWatch still equals ExpectedValue when checked, this thread sleeps until
+        /// @ref AtomicWakeAll is called on the same address. The check and going to sleep are done as one step, so
+        /// a change and wake that happen after the value was last read are not missed. On Linux this is a futex,
+        /// elsewhere this gives up the rest of this thread's timeslice instead.
+        /// @param VariableToWatch A pointer to the 32 bit integer other threads will change before waking this one.
+        /// @param ExpectedValue The value last read from VariableToWatch.
+        /// @note This can return early for any reason, check the value again after this returns.
+        void MEZZ_LIB AtomicWait(Int32* VariableToWatch, const Int32& ExpectedValue);
+
+        /// @brief Put the calling thread to sleep while a value is unchanged, for no longer than a timeout.
+        /// @details This is @ref AtomicWait, except it also returns once the timeout has passed.
+        /// @param VariableToWatch A pointer to the 32 bit integer other threads will change before waking this one.
+        /// @param ExpectedValue The value last read from VariableToWatch.
+        /// @param Microseconds The longest this sleeps.
+        /// @note This can return early for any reason, check the value again after this returns.
+        void MEZZ_LIB AtomicWaitFor(Int32* VariableToWatch, const Int32& ExpectedValue, const Whole& Microseconds);
+
+        /// @brief Wake every thread sleeping in @ref AtomicWait or @ref AtomicWaitFor on a value.
+        /// @param VariableToWatch A pointer to the 32 bit integer that was changed.
+        void MEZZ_LIB AtomicWakeAll(Int32* VariableToWatch);
 #endif
     }//Threading
 }//Mezzanine
@@ -43,8 +43,6 @@
 
 #include "barrier.h"
 
-#include <cassert>
-
 /// @file
 /// @brief Contains the implementation for the @ref Mezzanine::Threading::Barrier Barrier synchronization object.
 
@@ -52,37 +50,64 @@ namespace Mezzanine
 {
     namespace Threading
     {
-        Barrier::Barrier (const Int32& SynchThreadCount)
+        Barrier::Barrier (const Int32& SynchThreadCount, const Whole& SpinLimit_)
                         : ThreadGoal (SynchThreadCount),
-                          IsBlocking(1),
-                          ThreadCurrent (0)
+                          ThreadCurrent (0),
+                          Generation (0),
+                          SpinLimit (SpinLimit_)
         {}
 
-        bool Barrier::Wait()
+        bool Barrier::Trip(const Int32& Arrived)
         {
-            if(0==AtomicAdd(&IsBlocking,0)) // is a barrier breaking right now
+            if(Arrived<AtomicAdd(&ThreadGoal,0) || Arrived!=AtomicCompareAndSwap32(&ThreadCurrent,Arrived,0))
                 { return false; }
+            Release(); // Only after the count is reset, so the next use of this barrier starts counting at 0
+            return true;
+        }
+
+        void Barrier::Release()
+        {
+            AtomicAdd(&Generation,1);
+            AtomicWakeAll(&Generation);
+        }
 
-            if (AtomicAdd(&ThreadCurrent,1) >= ThreadGoal-1) //
+        void Barrier::WaitForRelease(const Int32& Sense)
+        {
+            for(Whole Spins = 0; Spins<SpinLimit; ++Spins)
             {
-                while(0!=AtomicCompareAndSwap32(&ThreadGoal,ThreadGoal,0));
-                AtomicAdd(&IsBlocking,-1);
-                assert(IsBlocking==0);
-                return true;
+                if(Sense!=AtomicLoad(&Generation))
+                    { return; }
+                SpinPause();
             }
-            else
-            {
-                while(AtomicAdd(&IsBlocking,0)); // intentionally spinning
+            while(Sense==AtomicLoad(&Generation))
+                { AtomicWait(&Generation,Sense); }
+        }
 
-                if(1==AtomicAdd(&ThreadCurrent,-1))
-                    { AtomicAdd(&IsBlocking,1); }
+        Barrier::~Barrier()
+            {}
 
-                return false;
-            }
+        bool Barrier::Wait()
+        {
+            Int32 Sense = AtomicAdd(&Generation,0);
+            if(Trip(AtomicAdd(&ThreadCurrent,1)+1))
+                { return true; }
+            WaitForRelease(Sense);
+            return false;
         }
 
+        bool Barrier::Wait(const Int32&)
+            { return Wait(); }
+
         void Barrier::SetThreadSyncCount(Int32 NewCount)
-            { while(ThreadGoal!=AtomicCompareAndSwap32(&ThreadGoal,ThreadGoal,NewCount)); }
+        {
+            while(ThreadGoal!=AtomicCompareAndSwap32(&ThreadGoal,ThreadGoal,NewCount));
+            Int32 Arrived = AtomicAdd(&ThreadCurrent,0);
+            if(0<Arrived)
+                { Trip(Arrived); }
+        }
+
+        Int32 Barrier::GetThreadSyncCount()
+            { return AtomicAdd(&ThreadGoal,0); }
 
     } // \Threading namespace
 } // \Mezzanine namespace
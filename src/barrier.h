@@ -55,31 +55,64 @@ namespace Mezzanine
     namespace Threading
     {
         /// @brief A synchronization primitive that causes a predefined number of threads to all wait before continuing.
+        /// @details This is sense reversing, each time the last thread arrives the barrier trips and changes its sense, so it
+        /// can be waited on again immediately with the same thread count. Waiting threads spin briefly then sleep until the
+        /// barrier trips, so threads waiting a long time, like between frames, do not occupy a CPU.
         class MEZZ_LIB Barrier
         {
             protected:
                 /// @brief The number of threads to have wait.
                 Int32 ThreadGoal;
 
-                /// @brief Does calling wait on this barrier block at presemt
-                /// @details 1 waits, and 0 does not any other value indicates a bug
-                Int32 IsBlocking;
-
                 /// @brief The number of threads currently waiting.
                 Int32 ThreadCurrent;
 
+                /// @brief The sense of the barrier, this changes each time the barrier trips and sleeping threads wait on it.
+                Int32 Generation;
+
+                /// @brief How many times a waiting thread checks for the barrier tripping before it sleeps.
+                Whole SpinLimit;
+
+                /// @brief Release every thread waiting if enough have arrived.
+                /// @param Arrived How many threads were counted as waiting when checked.
+                /// @return True if this call released the waiting threads, false if another thread did or not enough have arrived.
+                bool Trip(const Int32& Arrived);
+
+                /// @brief Change the sense of this barrier and wake every thread waiting on it.
+                void Release();
+
+                /// @brief Spin then sleep until this barrier trips.
+                /// @param Sense The value of the Generation read before arriving at this barrier.
+                void WaitForRelease(const Int32& Sense);
+
             public:
                 /// @brief Constructor
                 /// @param SynchThreadCount The amount of threads that this should wait for. If 0 is passed all threads waiting advance.
-                Barrier (const Int32& SynchThreadCount);
+                /// @param SpinLimit_ How many times a waiting thread checks the barrier before sleeping.
+                Barrier (const Int32& SynchThreadCount, const Whole& SpinLimit_ = 1024);
+
+                /// @brief Virtual destructor
+                virtual ~Barrier();
 
                 /// @brief Wait until the specified number of threads reach this point.
                 /// @return The last thread to reach this point gets true, the others are returned false.
-                bool Wait ();
+                virtual bool Wait ();
+
+                /// @brief Wait until the specified number of threads reach this point, identifying the calling thread.
+                /// @param ThreadIndex A number from 0 to one less than the thread count, that no other thread uses when waiting on this.
+                /// @details This barrier has every thread arrive at the same place so it ignores ThreadIndex. Other barriers can use it
+                /// to spread threads out.
+                /// @return The last thread to reach this point gets true, the others are returned false.
+                virtual bool Wait (const Int32& ThreadIndex);
 
                 /// @brief Set the Thread count Atomically.
                 /// @param NewCount The new amounf threads to sync.
-                void SetThreadSyncCount(Int32 NewCount);
+                /// @details If at least this many threads are already waiting they are released.
+                virtual void SetThreadSyncCount(Int32 NewCount);
+
+                /// @brief Get the amount of threads this synchronizes.
+                /// @return An Int32 with the current thread count.
+                Int32 GetThreadSyncCount();
 
         };//Barrier
     }//Threading
@@ -159,21 +159,15 @@
         #undef MEZZ_USEBARRIERSEACHFRAME
     #endif
 
-    /// @def MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-    /// @brief This is used to configure whether to atomically store a shortcut to skip checking all workunits.
-    /// @details When this is enabled @ref Mezzanine::Threading::AtomicCompareAndSwap32 "Atomic CAS" operations are used to maintain
-    /// a count of the number of complete workunits at the beginning of the work unit listings. Normally these
-    /// listings are read-only during frame execution, and the work units store whether or not they are
-    /// complete. The default algorithm forces iteration over a large number of work units to simply check for
-    /// completion in some situations. If memory bandwidth is slow or limited this can be a large source of
-    /// of contention. Enable this option when there are many work units trades atomic operations for memory
-    /// bandwidth. This must be tested on a per system basis to determine full preformance ramifications. This
-    /// is controlled by the CMake (or other build system) option Mezz_DecacheWorkUnits.
-    #ifndef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-        #define MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-    #endif
-    #ifndef _MEZZ_DECACHEWORKUNIT_
-        #undef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
+    /// @def MEZZ_USETHREADPOOL
+    /// @brief This is used to configure whether threads are kept parked between frames and reused.
+    /// @details This is the default, unless _MEZZ_MINTHREADS_ or _MEZZ_THREADSEACHFRAME_ are defined. This is controlled
+    /// by the CMake (or other build system) options Mezz_MinimizeThreadsEachFrame and Mezz_CreateThreadsEachFrame.
+    #ifndef MEZZ_USETHREADPOOL
+        #define MEZZ_USETHREADPOOL
+    #endif
+    #if defined(_MEZZ_MINTHREADS_) || defined(_MEZZ_THREADSEACHFRAME_)
+        #undef MEZZ_USETHREADPOOL
     #endif
 
     /// @def MEZZ_FRAMESTOTRACK
@@ -186,5 +180,39 @@
         #undef MEZZ_FRAMESTOTRACK
         #define MEZZ_FRAMESTOTRACK _MEZZ_FRAMESTOTRACK_
     #endif
+
+    /// @def MEZZ_MAXFRAMEWAIT
+    /// @brief The default longest pause between frames in microseconds. This is controlled by the CMake (or
+    /// other build system) option Mezz_MaxFrameWait and can be changed on each FrameScheduler.
+    #ifndef MEZZ_MAXFRAMEWAIT
+        #define MEZZ_MAXFRAMEWAIT 1000000
+    #endif
+    #ifdef _MEZZ_MAXFRAMEWAIT_
+        #undef MEZZ_MAXFRAMEWAIT
+        #define MEZZ_MAXFRAMEWAIT _MEZZ_MAXFRAMEWAIT_
+    #endif
+
+    /// @def MEZZ_MAXPACINGMARGIN
+    /// @brief The most microseconds a FrameScheduler will spin at the end of a pause between frames instead of
+    /// sleeping. This is controlled by the CMake (or other build system) option Mezz_MaxPacingMargin.
+    #ifndef MEZZ_MAXPACINGMARGIN
+        #define MEZZ_MAXPACINGMARGIN 1000
+    #endif
+    #ifdef _MEZZ_MAXPACINGMARGIN_
+        #undef MEZZ_MAXPACINGMARGIN
+        #define MEZZ_MAXPACINGMARGIN _MEZZ_MAXPACINGMARGIN_
+    #endif
+
+    /// @def MEZZ_TIMERRESOLUTION
+    /// @brief The length in microseconds of one tick of the @ref Mezzanine::Threading::TimerWheel "TimerWheel" a
+    /// FrameScheduler keeps its timers in, no timer expires more precisely than this. This is controlled by the CMake
+    /// (or other build system) option Mezz_TimerResolution.
+    #ifndef MEZZ_TIMERRESOLUTION
+        #define MEZZ_TIMERRESOLUTION 1000
+    #endif
+    #ifdef _MEZZ_TIMERRESOLUTION_
+        #undef MEZZ_TIMERRESOLUTION
+        #define MEZZ_TIMERRESOLUTION _MEZZ_TIMERRESOLUTION_
+    #endif
 #endif // include guard
 
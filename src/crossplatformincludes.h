@@ -106,6 +106,10 @@
     #include <signal.h>
     #include <sched.h>
     #include <unistd.h>
+    #ifdef __linux__
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+    #endif
 #endif
 
 #endif // include guard
@@ -96,7 +96,9 @@
 //#include "crossplatformincludes.h" // This is omitted because windows.h include a ton of macros that break clean code, so this vile file's scope must be minimized
 #include "crossplatformexport.h"
 #include "datatypes.h"
+#include "dependencygraph.h"
 #include "doublebufferedresource.h"
+#include "forkjoingroup.h"
 #include "framescheduler.h"
 #include "frameschedulerworkunits.h"
 #include "lockguard.h"
@@ -104,11 +106,16 @@
 #include "monopoly.h"
 #include "mutex.h"
 #include "readwritespinlock.h"
+#include "resumableworkunit.h"
 #include "rollingaverage.h"
 #include "spinlock.h"
 #include "systemcalls.h"
 #include "thread.h"
 #include "threadingenumerations.h"
+#include "threadteam.h"
+#include "timerwheel.h"
+#include "treebarrier.h"
+#include "workstealingdeque.h"
 #include "workunit.h"
 #include "workunitkey.h"
 #endif
@@ -326,13 +333,18 @@
 /// to spawn one thread and manage it without interfering with other execution. DMA, and other
 /// hardware coprocessors are expected to be utilized to their fullest to help accomplish this.
 ///     @li @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit" - These are expected
-/// to monopolize cpu resources at the beginning of each frame. This is ideal when working with
-/// other systems. For example a phsyics system like Bullet3D. If the calls to a physics system are
-/// wrapped in a @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit" then it will be
-/// given full opportunity to run before other work units.
+/// to monopolize cpu resources. This is ideal when working with other systems. For example a phsyics
+/// system like Bullet3D. If the calls to a physics system are wrapped in a
+/// @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit" then no other work unit runs
+/// while it does, and every thread the scheduler is using joins its
+/// @ref Mezzanine::Threading::ThreadTeam "ThreadTeam". Monopolies without dependencies run at the
+/// beginning of each frame, others run as soon as their dependencies are complete.
 ///
-/// Once all the @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit"s are done then the
-/// @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" class instance spawns or activates
+/// Any @ref Mezzanine::Threading::iWorkUnit "iWorkUnit" can instead be added with
+/// @ref Mezzanine::Threading::FrameScheduler::AddWorkUnitBackground() "FrameScheduler::AddWorkUnitBackground()"
+/// so it is not part of any frame and only runs, a slice at a time, in the pause between frames.
+///
+/// The @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" class instance spawns or activates
 /// a number of threads based on a simple heuristic. This heuristic is the way work units are sorted
 /// in preparation for execution. To understand how these are sorted, the dependency system needs to
 /// be understood.
@@ -382,14 +394,17 @@
 /// Internally this uses an @ref Mezzanine::Threading::AtomicCompareAndSwap32 "Atomic Compare And Swap"
 /// operation to maximize performance.
 /// By having the workunit manage the right to execute it removes the work queue as the primary source
-/// of contention that would prevent scaling. This does add another potential point of slowdowns though;
-/// threads must iterate over each other workunit until they reach the work to be executed. If atomic
-/// operations are used to maintain an iterator that keeps track of where to start searching for work,
-/// in a waitfree way, then we can trade the cost of this iteration for a number of atomic operations.
-/// On some systems this is a great idea, on others a terrible idea, so it is a
-/// @ref MEZZ_USEATOMICSTODECACHECOMPLETEWORK "CMake option called DecachingWork". Because this update
-/// can be skipped if it work incur a wait, it does not recreate a central workqueue's primary point of
-/// contention while providing all the benefits.
+/// of contention that would prevent scaling. Threads never search through work that is not ready either.
+/// The dependencies are frozen into a @ref Mezzanine::Threading::DependencyGraph "DependencyGraph"
+/// whenever workunits are added, removed or sorted. It gives every workunit a dense index and stores the
+/// dependents of each in one contiguous array (Compressed Sparse Row format), so walking it reads
+/// sequential integers instead of chasing pointers. Every workunit knows how many of its dependencies
+/// have not completed yet. When a workunit completes it atomically decrements that count on each of
+/// its dependents, and any that reach zero are pushed onto a ready max-heap, one for main workunits and
+/// one for workunits with affinity, ordered by priority. Finding work is then just popping the highest
+/// priority entry, no matter how many workunits are waiting on dependencies. With
+/// @ref Mezzanine::Threading::FrameScheduler::SetWorkStealing() "work stealing" enabled each thread
+/// keeps its own deque of ready work instead and takes from others when it runs dry.
 /// @image html DAGThreads.gif "DAG threads - Fig 5."
 /// @n @n
 /// Some work must be run on specific threads, such as calls to underlying devices (for example,
@@ -406,16 +421,21 @@
 /// For example loading a large file or listening for network traffic. These will be normal
 /// @ref Mezzanine::Threading::iWorkUnit "iWorkUnit"s in most regards and will check on the asynchronous
 /// tasks they manage each frame when they run as a normally scheduled.
+/// A @ref Mezzanine::Threading::ResumableWorkUnit "ResumableWorkUnit" that needs to wait on one of
+/// these, another WorkUnit or a timer suspends instead, and any thread continues it once whatever it
+/// waited on is ready.
 /// @n @n
 /// If a thread runs out of work because all the work is completed the frame will pause until it
 /// should start again the next frame. This pause length is calulated using a runtime configurable value
-/// on the @ref Mezzanine::Threading::FrameScheduler "FrameScheduler". If a thread has checked every
-/// @ref Mezzanine::Threading::iWorkUnit "iWorkUnit" and some are still not executing, but could not
-/// be started because of incomplete dependencies the thread will simply iterate over every
-/// @ref Mezzanine::Threading::iWorkUnit "iWorkUnit" in the
-/// @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" until the dependencies of one are
-/// met and allows one to be executed. This implicitly guarantees that at least one thread will
-/// always do work, and if dependencies chains are kept short then it is more likely that several
+/// on the @ref Mezzanine::Threading::FrameScheduler "FrameScheduler". Timers added with
+/// @ref Mezzanine::Threading::FrameScheduler::AddTimer() "FrameScheduler::AddTimer()" that expire
+/// during this pause run on the main thread as they do, and those expiring during a frame are run
+/// by any thread at the start of the next. If a thread finds nothing ready while some
+/// @ref Mezzanine::Threading::iWorkUnit "iWorkUnit"s are still waiting on their dependencies, it spins
+/// briefly, then parks on the scheduler's count of outstanding work. Completing a workunit lowers that
+/// count only after publishing whatever it released, and wakes parked threads, so they return to find
+/// the new work. When the count reaches zero every thread leaves. A thread waiting this way costs no
+/// processor time, and if dependency chains are kept short then it is more likely that several
 /// threads will advance.
 /// @subsection algorithmintegrate_sec Integrating with the Algorithm
 /// When
@@ -424,20 +444,15 @@
 /// this frame has consumed the amount of time it should, and the timer is restarted for the next
 /// frame.
 /// @n @n
-/// This process is actually divided into six steps. The function
+/// This process is actually divided into five steps. The function
 /// @ref Mezzanine::Threading::FrameScheduler::DoOneFrame() "FrameScheduler::DoOneFrame()"
-/// simply calls the following functions:
-/// @subsubsection integrate1 Step 1 - Run All the Monopolies
-/// The function
+/// simply calls the following functions. The
+/// @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit"s added with
+/// @ref Mezzanine::Threading::FrameScheduler::AddWorkUnitMonopoly() "FrameScheduler::AddWorkUnitMonopoly()"
+/// run during steps 1 through 3 with every thread. Calling
 /// @ref Mezzanine::Threading::FrameScheduler::RunAllMonopolies() "FrameScheduler::RunAllMonopolies()"
-/// simply iterates through all the @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit"
-/// that have been added with
-/// @ref Mezzanine::Threading::FrameScheduler::AddWorkUnitMonopoly() "FrameScheduler::AddWorkUnitMonopoly()".
-/// It does this in no specific order.
-/// @n @n
-/// In general @ref Mezzanine::Threading::MonopolyWorkUnit "MonopolyWorkUnit"s can be expected to use
-/// all available CPU resources. Other threads should not be executed in general.
-/// @subsubsection integrate2 Step 2 - Create and Start Threads
+/// before step 1 runs those without dependencies on the calling thread alone instead.
+/// @subsubsection integrate2 Step 1 - Create and Start Threads
 /// The function
 /// @ref Mezzanine::Threading::FrameScheduler::CreateThreads() "FrameScheduler::CreateThreads()"
 /// Creates enough threads to get to the amount set by
@@ -450,7 +465,7 @@
 /// (work units with affinity can affect how much work can be done with out waiting) that was added by
 /// @ref Mezzanine::Threading::FrameScheduler::AddWorkUnitMain(iWorkUnit *, const String&) "FrameScheduler::AddWorkUnitMain".
 /// If there is only one thread, the main thread, then this will return immediately and no work will be done.
-/// @subsubsection integrate3 Step 3 - Main Thread Work
+/// @subsubsection integrate3 Step 2 - Main Thread Work
 /// The call to
 /// @ref Mezzanine::Threading::FrameScheduler::RunMainThreadWork() "FrameScheduler::RunMainThreadWork()"
 /// will start the main thread executing work units. This is the call that executes work units added with
@@ -465,18 +480,22 @@
 /// though every work unit with affinity will be complete. There could be work in other threads still
 /// executing. This is another good point to run work that is single threaded and won't interfere with
 /// workunits that could be executing.
-/// @subsubsection integrate4 Step 4 - Clean Up Threads
+/// @subsubsection integrate4 Step 3 - Clean Up Threads
 /// If you must execute something that could interfere (write to anything they could read or write)
 /// with work units, you should do that after
 /// @ref Mezzanine::Threading::FrameScheduler::JoinAllThreads() "FrameScheduler::JoinAllThreads()" is
 /// called. This joins, destroys, or otherwise cleans up the threads the scheduler has used depending
 /// on how this library is configured.
-/// @subsubsection integrate5 Step 5 - Prepare for the next frame.
+/// @subsubsection integrate5 Step 4 - Prepare for the next frame.
 /// All the work units are marked as complete and need to be reset with
 /// @ref Mezzanine::Threading::FrameScheduler::ResetAllWorkUnits() "FrameScheduler::ResetAllWorkUnits()"
-/// to be used by the next frame. This simply iterates over each work unit resetting their status. A
-/// potential future optimization could run this as a multithreaded monopoly instead.
-/// @subsubsection integrate6 Step 6 - Wait for next frame.
+/// to be used by the next frame. This does not visit each work unit. It advances a frame epoch that every
+/// @ref Mezzanine::Threading::DefaultWorkUnit "DefaultWorkUnit" tags its state with, so any state set in an
+/// earlier frame reads as not started. Each work unit's count of remaining dependencies was already set for
+/// the next frame when it completed, so if the whole frame ran normally the ready heaps are simply copied
+/// from the set of work units without dependencies, found when the graph was last built. Only if some work
+/// did not finish, was skipped or deferred, or ran ahead are the counts seeded again, in one pass over the graph.
+/// @subsubsection integrate6 Step 5 - Wait for next frame.
 /// The final step is to wait until the next frame should begin. To do this tracking the begining of
 /// of each frame is required. The value in
 /// @ref Mezzanine::Threading::FrameScheduler::CurrentFrameStart "FrameScheduler::CurrentFrameStart"
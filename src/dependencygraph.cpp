@@ -0,0 +1,226 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _dependencygraph_cpp
+#define _dependencygraph_cpp
+
+#include "dependencygraph.h"
+#include "monopoly.h"
+
+#include <algorithm>
+
+/// @file
+/// @brief The implementation of the @ref Mezzanine::Threading::DependencyGraph the @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" schedules from.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        const Whole DependencyGraph::NotFound = Whole(-1);
+
+        void DependencyGraph::AddUnit(iWorkUnit* Unit)
+        {
+            Lookup.push_back(std::pair<iWorkUnit*, Whole>(Unit,Units.size()));
+            Units.push_back(Unit);
+        }
+
+        DependencyGraph::DependencyGraph()
+            : MainCount(0), AffinityCount(0), MonopolyCount(0)
+            {}
+
+        void DependencyGraph::Build(const std::vector<WorkUnitKey>& Main, const std::vector<WorkUnitKey>& Affinity, const std::vector<MonopolyWorkUnit*>& Monopolies)
+        {
+            Clear();
+            MainCount = Main.size();
+            AffinityCount = Affinity.size();
+            MonopolyCount = Monopolies.size();
+            for(std::vector<WorkUnitKey>::const_iterator Iter=Main.begin(); Iter!=Main.end(); ++Iter)
+                { AddUnit(Iter->Unit); }
+            for(std::vector<WorkUnitKey>::const_iterator Iter=Affinity.begin(); Iter!=Affinity.end(); ++Iter)
+                { AddUnit(Iter->Unit); }
+            for(std::vector<MonopolyWorkUnit*>::const_iterator Iter=Monopolies.begin(); Iter!=Monopolies.end(); ++Iter)
+                { AddUnit(*Iter); }
+            std::sort(Lookup.begin(),Lookup.end());
+
+            // Anything depended on that was not added to the scheduler still gets an index, so it can be logged
+            Whole KnownCount = Units.size();
+            for(Whole Index=0; Index<KnownCount; ++Index)
+            {
+                Whole Max = Units[Index]->GetImmediateDependencyCount();
+                for(Whole Counter=0; Counter<Max; ++Counter)
+                {
+                    iWorkUnit* Dependency = Units[Index]->GetDependency(Counter);
+                    if(NotFound==GetIndexOf(Dependency))
+                    {
+                        AddUnit(Dependency);
+                        std::inplace_merge(Lookup.begin(),Lookup.end()-1,Lookup.end());
+                    }
+                }
+            }
+
+            // The dependencies of everything this knows about, repeats are only recorded once
+            DependencyOffsets.reserve(Units.size()+1);
+            for(Whole Index=0; Index<Units.size(); ++Index)
+            {
+                DependencyOffsets.push_back(Dependencies.size());
+                if(Index>=KnownCount)
+                    { continue; }
+                Whole Max = Units[Index]->GetImmediateDependencyCount();
+                for(Whole Counter=0; Counter<Max; ++Counter)
+                {
+                    Whole Dependency = GetIndexOf(Units[Index]->GetDependency(Counter));
+                    if(std::find(Dependencies.begin()+DependencyOffsets.back(),Dependencies.end(),Dependency)==Dependencies.end())
+                        { Dependencies.push_back(Dependency); }
+                }
+            }
+            DependencyOffsets.push_back(Dependencies.size());
+
+            // Dependents are the reverse of the dependencies of scheduled WorkUnits, counted first so they can be placed directly
+            Whole ScheduledCount = GetScheduledCount();
+            DependentOffsets.assign(Units.size()+1,0);
+            for(Whole Index=0; Index<ScheduledCount; ++Index)
+            {
+                for(ConstIterator Iter=DependenciesBegin(Index); Iter!=DependenciesEnd(Index); ++Iter)
+                    { DependentOffsets[*Iter+1]++; }
+            }
+            for(Whole Index=0; Index<Units.size(); ++Index)
+                { DependentOffsets[Index+1] += DependentOffsets[Index]; }
+            Dependents.resize(DependentOffsets.back());
+            std::vector<Whole> Filled(DependentOffsets.begin(),DependentOffsets.end()-1);
+            for(Whole Index=0; Index<ScheduledCount; ++Index)
+            {
+                for(ConstIterator Iter=DependenciesBegin(Index); Iter!=DependenciesEnd(Index); ++Iter)
+                    { Dependents[Filled[*Iter]++] = Index; }
+            }
+
+            // Kahn's algorithm over the edges that are recorded in both directions
+            std::vector<Whole> Waiting(Units.size(),0);
+            for(Whole Index=0; Index<ScheduledCount; ++Index)
+                { Waiting[Index] = DependencyOffsets[Index+1]-DependencyOffsets[Index]; }
+            Order.reserve(Units.size());
+            for(Whole Index=0; Index<Units.size(); ++Index)
+            {
+                if(0==Waiting[Index])
+                    { Order.push_back(Index); }
+            }
+            for(Whole Visited=0; Visited<Order.size(); ++Visited)
+            {
+                Whole Current = Order[Visited];
+                for(ConstIterator Iter=DependentsBegin(Current); Iter!=DependentsEnd(Current); ++Iter)
+                {
+                    if(0==--Waiting[*Iter])
+                        { Order.push_back(*Iter); }
+                }
+            }
+        }
+
+        void DependencyGraph::Clear()
+        {
+            Units.clear();
+            Lookup.clear();
+            DependencyOffsets.clear();
+            Dependencies.clear();
+            DependentOffsets.clear();
+            Dependents.clear();
+            Order.clear();
+            MainCount = 0;
+            AffinityCount = 0;
+            MonopolyCount = 0;
+        }
+
+        Whole DependencyGraph::GetUnitCount() const
+            { return Units.size(); }
+
+        Whole DependencyGraph::GetMainCount() const
+            { return MainCount; }
+
+        Whole DependencyGraph::GetScheduledCount() const
+            { return MainCount+AffinityCount+MonopolyCount; }
+
+        bool DependencyGraph::IsMonopoly(const Whole& Index) const
+            { return Index>=MainCount+AffinityCount && Index<MainCount+AffinityCount+MonopolyCount; }
+
+        iWorkUnit* DependencyGraph::GetUnit(const Whole& Index) const
+            { return Units[Index]; }
+
+        Whole DependencyGraph::GetIndexOf(iWorkUnit* Unit) const
+        {
+            std::vector< std::pair<iWorkUnit*, Whole> >::const_iterator Found =
+                    std::lower_bound(Lookup.begin(), Lookup.end(), std::pair<iWorkUnit*, Whole>(Unit,0));
+            if(Found!=Lookup.end() && Found->first==Unit)
+                { return Found->second; }
+            return NotFound;
+        }
+
+        DependencyGraph::ConstIterator DependencyGraph::DependenciesBegin(const Whole& Index) const
+            { return Dependencies.begin()+DependencyOffsets[Index]; }
+
+        DependencyGraph::ConstIterator DependencyGraph::DependenciesEnd(const Whole& Index) const
+            { return Dependencies.begin()+DependencyOffsets[Index+1]; }
+
+        Whole DependencyGraph::GetScheduledDependencyCount(const Whole& Index) const
+        {
+            Whole Results = 0;
+            Whole ScheduledCount = GetScheduledCount();
+            for(ConstIterator Iter=DependenciesBegin(Index); Iter!=DependenciesEnd(Index); ++Iter)
+            {
+                if(*Iter<ScheduledCount)
+                    { Results++; }
+            }
+            return Results;
+        }
+
+        DependencyGraph::ConstIterator DependencyGraph::DependentsBegin(const Whole& Index) const
+            { return Dependents.begin()+DependentOffsets[Index]; }
+
+        DependencyGraph::ConstIterator DependencyGraph::DependentsEnd(const Whole& Index) const
+            { return Dependents.begin()+DependentOffsets[Index+1]; }
+
+        Whole DependencyGraph::GetDependentCount(const Whole& Index) const
+            { return DependentOffsets[Index+1]-DependentOffsets[Index]; }
+
+        DependencyGraph::ConstIterator DependencyGraph::OrderBegin() const
+            { return Order.begin(); }
+
+        DependencyGraph::ConstIterator DependencyGraph::OrderEnd() const
+            { return Order.end(); }
+    }//Threading
+}//Mezzanine
+#endif
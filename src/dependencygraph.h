@@ -0,0 +1,195 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _dependencygraph_h
+#define _dependencygraph_h
+
+#include "datatypes.h"
+#include "workunitkey.h"
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::DependencyGraph the @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" schedules from.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        class iWorkUnit;
+        class MonopolyWorkUnit;
+
+        /// @brief A frozen copy of the dependencies between all the WorkUnits a @ref FrameScheduler knows about.
+        /// @details Each WorkUnit is given a dense index when this is built. Main WorkUnits get the lowest indexes in the
+        /// same order as the container they came from, then WorkUnits with affinity, then Monopolies, and finally any
+        /// WorkUnit that something depends on but that was never added to the scheduler. Because the containers of
+        /// main and affinity WorkUnits are sorted, a higher index among those is always a higher priority.
+        /// @n @n
+        /// The dependencies and dependents of every WorkUnit are each stored in one contiguous array with an offset per
+        /// index (Compressed Sparse Row format). Walking the graph is then a matter of reading sequential integers rather
+        /// than chasing pointers through tree nodes, and rebuilding it reuses the same few allocations.
+        /// @n @n
+        /// Only main and affinity WorkUnits and Monopolies are recorded as dependents. This matches what the scheduler waits
+        /// on, WorkUnits the scheduler does not know about never run.
+        class MEZZ_LIB DependencyGraph
+        {
+            public:
+                /// @brief A way to read the indexes of dependencies or dependents of one WorkUnit.
+                typedef std::vector<Whole>::const_iterator ConstIterator;
+
+            protected:
+                /// @brief The WorkUnit at each index.
+                std::vector<iWorkUnit*> Units;
+
+                /// @brief Every WorkUnit paired with its index, sorted by pointer for lookups.
+                std::vector< std::pair<iWorkUnit*, Whole> > Lookup;
+
+                /// @brief Where the dependencies of each index start in Dependencies, with one extra entry marking the end.
+                std::vector<Whole> DependencyOffsets;
+
+                /// @brief The indexes of the direct dependencies of every WorkUnit, grouped by WorkUnit.
+                std::vector<Whole> Dependencies;
+
+                /// @brief Where the dependents of each index start in Dependents, with one extra entry marking the end.
+                std::vector<Whole> DependentOffsets;
+
+                /// @brief The indexes of the scheduled WorkUnits that directly depend on each WorkUnit, grouped by WorkUnit.
+                std::vector<Whole> Dependents;
+
+                /// @brief Every index ordered so that each comes after all of its dependencies.
+                std::vector<Whole> Order;
+
+                /// @brief How many main WorkUnits there are, they are at the start of the indexes.
+                Whole MainCount;
+
+                /// @brief How many WorkUnits with affinity there are, they follow the main WorkUnits.
+                Whole AffinityCount;
+
+                /// @brief How many Monopolies there are, they follow the WorkUnits with affinity.
+                Whole MonopolyCount;
+
+                /// @brief Give an index to a WorkUnit that does not have one yet.
+                /// @param Unit The WorkUnit to add.
+                void AddUnit(iWorkUnit* Unit);
+
+            public:
+                /// @brief The value @ref GetIndexOf returns for a WorkUnit that is not in the graph.
+                static const Whole NotFound;
+
+                /// @brief Constructor, creates an empty graph.
+                DependencyGraph();
+
+                /// @brief Discard the current graph and freeze a copy of the current dependencies.
+                /// @param Main The main WorkUnits in priority order.
+                /// @param Affinity The WorkUnits with affinity in priority order.
+                /// @param Monopolies The Monopolies.
+                void Build(const std::vector<WorkUnitKey>& Main, const std::vector<WorkUnitKey>& Affinity, const std::vector<MonopolyWorkUnit*>& Monopolies);
+
+                /// @brief Remove every WorkUnit from the graph.
+                void Clear();
+
+                /// @brief How many WorkUnits of any kind are in the graph.
+                /// @return A Whole containing the count of indexes.
+                Whole GetUnitCount() const;
+
+                /// @brief How many main WorkUnits are in the graph.
+                /// @return A Whole, every index lower than this is a main WorkUnit.
+                Whole GetMainCount() const;
+
+                /// @brief How many main and affinity WorkUnits and Monopolies are in the graph.
+                /// @return A Whole, every index lower than this is a WorkUnit the scheduler runs from the graph.
+                Whole GetScheduledCount() const;
+
+                /// @brief Is the WorkUnit at an index a Monopoly?
+                /// @param Index The index of the WorkUnit.
+                /// @return True if the index is one of the Monopolies, which directly precede the unscheduled WorkUnits.
+                bool IsMonopoly(const Whole& Index) const;
+
+                /// @brief Get the WorkUnit at an index.
+                /// @param Index The index of the WorkUnit.
+                /// @return A pointer to the WorkUnit.
+                iWorkUnit* GetUnit(const Whole& Index) const;
+
+                /// @brief Find the index of a WorkUnit.
+                /// @param Unit The WorkUnit to find.
+                /// @return The index of the WorkUnit or @ref NotFound if it is not in the graph.
+                Whole GetIndexOf(iWorkUnit* Unit) const;
+
+                /// @brief Get the start of the indexes of the direct dependencies of a WorkUnit.
+                /// @param Index The index of the WorkUnit.
+                /// @return An iterator to the first dependency.
+                ConstIterator DependenciesBegin(const Whole& Index) const;
+
+                /// @brief Get the end of the indexes of the direct dependencies of a WorkUnit.
+                /// @param Index The index of the WorkUnit.
+                /// @return An iterator one past the last dependency.
+                ConstIterator DependenciesEnd(const Whole& Index) const;
+
+                /// @brief How many direct dependencies of a WorkUnit are main or affinity WorkUnits or Monopolies.
+                /// @param Index The index of the WorkUnit.
+                /// @return A Whole containing how many dependencies the scheduler waits on before this WorkUnit can start.
+                Whole GetScheduledDependencyCount(const Whole& Index) const;
+
+                /// @brief Get the start of the indexes of the WorkUnits that directly depend on a WorkUnit.
+                /// @param Index The index of the WorkUnit.
+                /// @return An iterator to the first dependent.
+                ConstIterator DependentsBegin(const Whole& Index) const;
+
+                /// @brief Get the end of the indexes of the WorkUnits that directly depend on a WorkUnit.
+                /// @param Index The index of the WorkUnit.
+                /// @return An iterator one past the last dependent.
+                ConstIterator DependentsEnd(const Whole& Index) const;
+
+                /// @brief How many WorkUnits directly depend on a WorkUnit.
+                /// @param Index The index of the WorkUnit.
+                /// @return A Whole containing the count.
+                Whole GetDependentCount(const Whole& Index) const;
+
+                /// @brief Get the start of every index ordered so each comes after all of its dependencies.
+                /// @details Walk this backwards to visit every WorkUnit after all of its dependents. WorkUnits caught in a
+                /// dependency cycle cannot be ordered and are left out.
+                /// @return An iterator to the first index.
+                ConstIterator OrderBegin() const;
+
+                /// @brief Get the end of the topological ordering.
+                /// @return An iterator one past the last index.
+                ConstIterator OrderEnd() const;
+        };//DependencyGraph
+    }//Threading
+}//Mezzanine
+#endif
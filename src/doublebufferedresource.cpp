@@ -53,7 +53,8 @@ namespace Mezzanine
     namespace Threading
     {
         ThreadSpecificStorage::ThreadSpecificStorage(FrameScheduler* Scheduler_) :
-            Scheduler(Scheduler_)
+            Scheduler(Scheduler_),
+            NumaNode(-1)
         {
             this->ThreadResources.push_back((ConvertiblePointer)new DoubleBufferedLogger);  // must comes first so it lands in spot 0
         }
@@ -64,6 +65,24 @@ namespace Mezzanine
         FrameScheduler* ThreadSpecificStorage::GetFrameScheduler()
             { return Scheduler; }
 
+        WorkStealingDeque& ThreadSpecificStorage::GetLocalWork()
+            { return LocalWork; }
+
+        Int32 ThreadSpecificStorage::GetNumaNode() const
+            { return NumaNode; }
+
+        void ThreadSpecificStorage::PlaceOnNode(const Int32& Node)
+        {
+            DoubleBufferedLogger* OldLogger = (DoubleBufferedLogger*)this->ThreadResources[DBRLogger];
+            DoubleBufferedLogger* NewLogger = new DoubleBufferedLogger;
+            NewLogger->GetUsable() << OldLogger->GetUsable().rdbuf()->str();
+            NewLogger->GetCommittable() << OldLogger->GetCommittable().rdbuf()->str();
+            this->ThreadResources[DBRLogger] = (ConvertiblePointer)NewLogger;
+            delete OldLogger;
+            LocalWork.Relocate();
+            NumaNode = Node;
+        }
+
         Whole ThreadSpecificStorage::GetLastFrameTime() const
             { return Scheduler->GetLastFrameTime() ; }
 
@@ -43,6 +43,10 @@
 
 #include "datatypes.h"
 
+#if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
+#include "workstealingdeque.h"
+#endif
+
 /// @file
 /// @brief This file defines the template double buffered resources that can be attached to a thread.
 
@@ -151,6 +155,12 @@ namespace Mezzanine
                 /// @brief A pointer to the FrameScheduler that this belongs to.
                 FrameScheduler* Scheduler;
 
+                /// @brief The ready work this thread owns when the FrameScheduler is work stealing.
+                WorkStealingDeque LocalWork;
+
+                /// @brief The NUMA node the resources were last placed on, -1 if they are wherever they were allocated.
+                Int32 NumaNode;
+
             public:
                 /// @brief A constructor that automatically creates the resources it supports
                 ThreadSpecificStorage(FrameScheduler* Scheduler_);
@@ -175,6 +185,24 @@ namespace Mezzanine
                 /// @return A pointer to the FrameScheduler that owns this resource.
                 FrameScheduler* GetFrameScheduler();
 
+                /// @brief Get the deque of ready work owned by this thread.
+                /// @details This is only active during a frame when the FrameScheduler is work stealing. Only the thread
+                /// this storage belongs to may push or pop, any thread may steal.
+                /// @return A reference to the WorkStealingDeque.
+                WorkStealingDeque& GetLocalWork();
+
+                /// @brief Which NUMA node were the resources of this thread last placed on?
+                /// @return The node passed to the last call to @ref PlaceOnNode, or -1 if it has not been called.
+                Int32 GetNumaNode() const;
+
+                /// @brief Reallocate the resources of this thread from the calling thread, so they are first touched on its NUMA node.
+                /// @param Node The NUMA node of the calling thread, which will be returned by @ref GetNumaNode.
+                /// @details The contents of each resource are kept. Derived classes that add resources should move those too
+                /// and then call this.
+                /// @warning This must only be called by the thread this storage belongs to, while the committable resources are
+                /// not being aggregated and the @ref WorkStealingDeque returned by @ref GetLocalWork is not active.
+                virtual void PlaceOnNode(const Int32& Node);
+
                 /// @copydoc FrameScheduler::GetLastFrameTime() const
                 Whole GetLastFrameTime() const;
 
@@ -0,0 +1,107 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _forkjoingroup_h
+#define _forkjoingroup_h
+
+#include "datatypes.h"
+#include "doublebufferedresource.h"
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::ForkJoinGroup ForkJoinGroup a running WorkUnit splits its work with.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        /// @brief A piece of work a running WorkUnit hands to the scheduler's threads.
+        /// @param Argument Whatever was passed to @ref ForkJoinGroup::Fork along with this function.
+        /// @param CurrentThread The resources of the thread actually running it, which may not be the thread that forked it.
+        typedef void (*ForkedFunction)(void* Argument, DefaultThreadSpecificStorage::Type& CurrentThread);
+
+        /// @brief Lets a running WorkUnit split its work into child tasks that idle scheduler threads help run.
+        /// @details A WorkUnit is run by the one thread that acquired it, so a WorkUnit with a lot of work to do, like a
+        /// collision broadphase, can keep other threads idle near the end of a frame. Create one of these in
+        /// @ref iWorkUnit::DoWork "DoWork", @ref Fork a task for each independent piece of the work, then @ref Join.
+        /// Threads looking for work in the same frame run forked tasks before they start another WorkUnit, and the thread
+        /// joining runs tasks itself until every one forked through this has completed.
+        /// @n @n
+        /// Tasks may fork and join their own groups. The WorkUnit's dependents are not released until it returns from
+        /// DoWork, so tasks may use anything the WorkUnit could.
+        class MEZZ_LIB ForkJoinGroup
+        {
+            private:
+                /// @brief The resources of the thread running the WorkUnit that created this.
+                DefaultThreadSpecificStorage::Type& CurrentThread;
+
+                /// @brief How many tasks forked through this have not yet completed.
+                Int32 Pending;
+
+                /// @brief Deny Copy construction, tasks are counted on a specific instance.
+                ForkJoinGroup(const ForkJoinGroup&);
+
+                /// @brief Deny Assignment, tasks are counted on a specific instance.
+                void operator=(const ForkJoinGroup&);
+
+            public:
+                /// @brief Constructor.
+                /// @param CurrentThreadStorage The resources passed to the DoWork of the WorkUnit creating this.
+                explicit ForkJoinGroup(DefaultThreadSpecificStorage::Type& CurrentThreadStorage);
+
+                /// @brief Destructor, calls @ref Join so no task can outlive the data it was given.
+                ~ForkJoinGroup();
+
+                /// @brief Make a task available for any of the scheduler's threads to run.
+                /// @param Function The work to do.
+                /// @param Argument Passed to Function, this must remain valid until @ref Join returns.
+                /// @details Tasks can run in any order, even on the calling thread.
+                void Fork(ForkedFunction Function, void* Argument);
+
+                /// @brief Run forked tasks on this thread until all forked through this have completed.
+                void Join();
+
+                /// @brief How many tasks forked through this have not completed yet?
+                /// @return A Whole that can change at any time while tasks are running, 0 after @ref Join.
+                Whole GetPendingCount() const;
+        };//ForkJoinGroup
+    }//Threading
+}//Mezzanine
+
+#endif
@@ -42,12 +42,12 @@
 #define _framescheduler_cpp
 
 #include "framescheduler.h"
+#include "asynchronousworkunit.h"
+#include "atomicoperations.h"
 #include "doublebufferedresource.h"
 #include "monopoly.h"
 #include "frameschedulerworkunits.h"
-#ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-    #include "atomicoperations.h"
-#endif
+#include "resumableworkunit.h"
 
 
 #include <exception>
@@ -73,53 +73,192 @@ namespace Mezzanine
 
         /// @cond false
 
+        namespace
+        {
+        /// @brief Where a logical processor sits relative to the others, used to order them for a ThreadAffinityPolicy.
+        struct AffinityRank
+        {
+            /// @brief The operating system's ID for the logical processor.
+            Whole ID;
+            /// @brief The index of its package, counting from 0.
+            Whole Package;
+            /// @brief The index of its core within its package, counting from 0.
+            Whole Core;
+            /// @brief The index of this logical processor amongst the others on its core, 0 for the first hyperthread.
+            Whole Sibling;
+        };
+
+        /// @brief Sort LogicalCPUs by package, core and then ID.
+        bool TopologyLess(const LogicalCPU& Left, const LogicalCPU& Right)
+        {
+            if(Left.Package!=Right.Package)
+                { return Left.Package<Right.Package; }
+            if(Left.Core!=Right.Core)
+                { return Left.Core<Right.Core; }
+            return Left.ID<Right.ID;
+        }
+
+        /// @brief Replace the arbitrary core and package IDs the operating system uses with dense indexes.
+        /// @param Topology The logical processors to rank.
+        /// @return One AffinityRank per logical processor, in compact order.
+        std::vector<AffinityRank> RankCPUs(std::vector<LogicalCPU> Topology)
+        {
+            std::sort(Topology.begin(), Topology.end(), TopologyLess);
+            std::vector<AffinityRank> Results;
+            for(std::vector<LogicalCPU>::const_iterator Iter = Topology.begin(); Iter!=Topology.end(); ++Iter)
+            {
+                AffinityRank Current = { Iter->ID, 0, 0, 0 };
+                if(!Results.empty())
+                {
+                    const AffinityRank& Last = Results.back();
+                    std::vector<LogicalCPU>::const_iterator Previous = Iter-1;
+                    if(Previous->Package!=Iter->Package)
+                        { Current.Package = Last.Package+1; }
+                    else if(Previous->Core!=Iter->Core)
+                        { Current.Package = Last.Package; Current.Core = Last.Core+1; }
+                    else
+                        { Current.Package = Last.Package; Current.Core = Last.Core; Current.Sibling = Last.Sibling+1; }
+                }
+                Results.push_back(Current);
+            }
+            return Results;
+        }
+
+        /// @brief Orders AffinityRanks so the first is where the main thread goes, the second is for the first worker and so on.
+        class AffinityOrder
+        {
+            private:
+                /// @brief The ordering to sort by.
+                ThreadAffinityPolicy Policy;
+
+            public:
+                /// @brief Constructor
+                /// @param Policy_ The ordering to sort by, one of the policies that uses the topology.
+                AffinityOrder(ThreadAffinityPolicy Policy_) : Policy(Policy_)
+                    {}
+
+                /// @brief Compare two logical processors.
+                /// @return True if the Left one should be used before the Right one.
+                bool operator()(const AffinityRank& Left, const AffinityRank& Right) const
+                {
+                    Whole LeftKey[3], RightKey[3];
+                    if(ScatterAffinity==Policy)
+                    {
+                        LeftKey[0] = Left.Sibling;  LeftKey[1] = Left.Core;     LeftKey[2] = Left.Package;
+                        RightKey[0] = Right.Sibling; RightKey[1] = Right.Core;   RightKey[2] = Right.Package;
+                    }else if(PhysicalCoresFirstAffinity==Policy){
+                        LeftKey[0] = Left.Sibling;  LeftKey[1] = Left.Package;  LeftKey[2] = Left.Core;
+                        RightKey[0] = Right.Sibling; RightKey[1] = Right.Package; RightKey[2] = Right.Core;
+                    }else{
+                        LeftKey[0] = Left.Package;  LeftKey[1] = Left.Core;     LeftKey[2] = Left.Sibling;
+                        RightKey[0] = Right.Package; RightKey[1] = Right.Core;   RightKey[2] = Right.Sibling;
+                    }
+                    for(Whole Counter = 0; Counter<3; ++Counter)
+                    {
+                        if(LeftKey[Counter]!=RightKey[Counter])
+                            { return LeftKey[Counter]<RightKey[Counter]; }
+                    }
+                    return Left.ID<Right.ID;
+                }
+        };
+        }
+
         /// @brief This is the function that all threads will run, except the main.
         /// @param ThreadStorage A pointer to a ThreadSpecificStorage that has the required data for a thread after it launches.
         void ThreadWork(void* ThreadStorage)
         {
             DefaultThreadSpecificStorage::Type& Storage = *((DefaultThreadSpecificStorage::Type*)ThreadStorage);
             FrameScheduler& FS = *(Storage.GetFrameScheduler());
-            iWorkUnit* CurrentUnit;
+            iWorkUnit* CurrentUnit = 0;
 
+            #ifndef MEZZ_USETHREADPOOL
+            Int32 Index = 1; // Resources do not change until every thread reaches EndFrameSync or is joined
+            while(FS.Resources[Index]!=ThreadStorage)
+                { ++Index; }
+            Int32 PinnedGeneration = 0;
+            #endif
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-            while(!FS.LastFrame)
+            for(;;) // A thread is created during the frame it is first needed, so it starts working immediately
             {
-                FS.StartFrameSync.Wait(); // Syncs with Main thread in CreateThreads()
-                if(FS.LastFrame)
-                    { break; }
+            #endif
+            #ifndef MEZZ_USETHREADPOOL
+                FS.UpdateThreadAffinity(Index,PinnedGeneration);
             #endif
 
-                do
+                for(Int32 Outstanding = FS.GetOutstandingWorkUnitCount(); 0<Outstanding;
+                    Outstanding = FS.ServeThreadTeam(Storage) ? FS.GetOutstandingWorkUnitCount() : FS.WaitForWorkUnitCompletion(Outstanding))
                 {
-                    while( (CurrentUnit = FS.GetNextWorkUnit()) ) /// @todo needs to skip ahead a unit instead of spinning
+                    FS.ResumeDueWorkUnits();
+                    do
                     {
-                        if(Starting==CurrentUnit->TakeOwnerShip())
-                            { CurrentUnit->operator()(Storage); }
-                    }
-                } while(!FS.AreAllWorkUnitsComplete());
+                        while( FS.RunForkedTask(Storage) || (CurrentUnit = FS.GetNextWorkUnit(Storage)) ) // Help WorkUnits already running before starting another
+                        {
+                            if(CurrentUnit && Starting==CurrentUnit->TakeOwnerShip())
+                                { CurrentUnit->operator()(Storage); }
+                            CurrentUnit = 0;
+                        }
+                    }while(FS.RunWorkUnitAhead(Storage)); // Only start the next frame's work when there is none left in this one
+                }
 
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-                FS.EndFrameSync.Wait(); // Syncs with Main thread in JoinAllThreads()
+                FS.EndFrameSync->Wait(Index); // Syncs with Main thread in JoinAllThreads()
+                FS.StartFrameSync->Wait(Index); // Syncs with Main thread in CreateThreads()
+                if(AtomicAdd(&FS.LastFrame,0) || Index>=AtomicAdd(&FS.SyncedThreadCount,0))
+                    { break; } // Shutting down or retired
             }
             #endif
         }
 
+        #ifdef MEZZ_USETHREADPOOL
+        /// @brief This is the function that threads in the pool run, it does the work of each frame and parks between them.
+        /// @param ThreadStorage A pointer to a ThreadSpecificStorage that has the required data for a thread after it launches.
+        void ThreadWorkPool(void* ThreadStorage)
+        {
+            FrameScheduler& FS = *(((DefaultThreadSpecificStorage::Type*)ThreadStorage)->GetFrameScheduler());
+            Int32 Index = 1; // Resources do not change until every thread in the pool finishes this frame
+            while(FS.Resources[Index]!=ThreadStorage)
+                { ++Index; }
+
+            // A thread is created during the frame it is first needed, so it starts working immediately
+            Int32 PinnedGeneration = 0;
+
+            for(Int32 Frame = AtomicAdd(&FS.PoolFrame,0); Index<AtomicAdd(&FS.PoolSize,0); Frame = AtomicAdd(&FS.PoolFrame,0))
+            {
+                if(AtomicAdd(&FS.PoolBackground,0))
+                    { FS.RunBackgroundWork(*((DefaultThreadSpecificStorage::Type*)ThreadStorage)); } // Woken for the pause between frames
+                else
+                {
+                    FS.UpdateThreadAffinity(Index,PinnedGeneration);
+                    ThreadWork(ThreadStorage);
+                }
+                if(1==AtomicAdd(&FS.PoolWorking,-1))
+                    { AtomicWakeAll(&FS.PoolWorking); } // Syncs with Main thread in JoinAllThreads()
+                while(Frame==AtomicAdd(&FS.PoolFrame,0))
+                    { AtomicWait(&FS.PoolFrame,Frame); } // Syncs with Main thread in CreateThreads()
+            }
+        }
+        #endif
+
         /// @brief This is the function that the main thread runs.
         /// @param ThreadStorage A pointer to a ThreadSpecificStorage that has the required data for a thread after it launches.
         void ThreadWorkAffinity(void* ThreadStorage)
         {
             DefaultThreadSpecificStorage::Type& Storage = *((DefaultThreadSpecificStorage::Type*)ThreadStorage);
             FrameScheduler& FS = *(Storage.GetFrameScheduler());
-            iWorkUnit* CurrentUnit;
-            do
+            iWorkUnit* CurrentUnit = 0;
+            for(Int32 Outstanding = FS.GetOutstandingWorkUnitCount(); 0<Outstanding; Outstanding = FS.WaitForWorkUnitCompletion(Outstanding))
             {
-                while( (CurrentUnit = FS.GetNextWorkUnitAffinity()) ) /// @todo needs to skip ahead a unit instead of spinning
+                FS.ResumeDueWorkUnits();
+                do
                 {
-                    if(Starting==CurrentUnit->TakeOwnerShip())
-                        { CurrentUnit->operator()(Storage); }
-                }
+                    while( FS.RunForkedTask(Storage) || (CurrentUnit = FS.GetNextWorkUnitAffinity(Storage)) )
+                    {
+                        if(CurrentUnit && Starting==CurrentUnit->TakeOwnerShip())
+                            { CurrentUnit->operator()(Storage); }
+                        CurrentUnit = 0;
+                    }
+                }while(FS.RunWorkUnitAhead(Storage));
             }
-            while(!FS.AreAllWorkUnitsComplete());
         }
         /// @endcond
 
@@ -130,8 +269,25 @@ namespace Mezzanine
         {
             #ifdef MEZZ_USEBARRIERSEACHFRAME
             while(1!=AtomicCompareAndSwap32(&LastFrame,LastFrame,1));
-            StartFrameSync.SetThreadSyncCount(0);
-            EndFrameSync.SetThreadSyncCount(0); // Handle situations where Threads have not been created yet
+            StartFrameSync->SetThreadSyncCount(0);
+            EndFrameSync->SetThreadSyncCount(0); // Handle situations where Threads have not been created yet
+            for(std::vector<Thread*>::iterator Iter=Threads.begin(); Iter!=Threads.end(); ++Iter)
+            {
+                (*Iter)->join();
+                delete *Iter;
+            }
+            Threads.clear();
+            #elif defined(MEZZ_USETHREADPOOL)
+            JoinAllThreads();
+            PoolSize = 0; // Every thread in the pool exits when woken
+            AtomicAdd(&PoolFrame,1);
+            AtomicWakeAll(&PoolFrame);
+            for(std::vector<Thread*>::iterator Iter=Threads.begin(); Iter!=Threads.end(); ++Iter)
+            {
+                (*Iter)->join();
+                delete *Iter;
+            }
+            Threads.clear();
             #else
             JoinAllThreads();
             #endif
@@ -143,27 +299,504 @@ namespace Mezzanine
                 { delete *Iter; }
         }
 
-        void FrameScheduler::UpdateDependentGraph(const std::vector<WorkUnitKey>& Units)
+        void FrameScheduler::UpdateThreadCount()
+        {
+            if(!AdaptiveThreadCount || !TargetFrameLength)
+                { return; }
+            MaxInt WorkLength = CurrentPauseStart-CurrentFrameStart;
+            MaxInt Capacity = WorkLength*CurrentThreadCount;
+            MaxInt Idle = std::min(MaxInt(AtomicAdd(&IdleTime,0)),Capacity);
+            MaxInt Busy = Capacity-Idle;
+
+            if(WorkLength*10>MaxInt(TargetFrameLength)*9)
+            {
+                FramesWithSpareThreads = 0;
+                if(CurrentThreadCount<MaximumThreadCount && Busy>WorkLength*(CurrentThreadCount-1)) // Another thread only helps if the others were nearly always busy
+                    { CurrentThreadCount++; }
+            }else if(CurrentThreadCount>MinimumThreadCount && Busy/(CurrentThreadCount-1)*2<MaxInt(TargetFrameLength)){
+                if(++FramesWithSpareThreads>=MEZZ_FRAMESTOTRACK)
+                {
+                    FramesWithSpareThreads = 0;
+                    CurrentThreadCount--;
+                }
+            }else{
+                FramesWithSpareThreads = 0;
+            }
+
+            if(CurrentThreadCount<MinimumThreadCount)
+                { CurrentThreadCount = MinimumThreadCount; }
+            if(CurrentThreadCount>MaximumThreadCount)
+                { CurrentThreadCount = std::max(MaximumThreadCount,MinimumThreadCount); }
+        }
+
+        void FrameScheduler::UpdateThreadAffinity(const Whole& Index, Int32& PinnedGeneration)
+        {
+            if(PinnedGeneration!=AffinityGeneration)
+            {
+                bool Pinned = AffinityCPUs.empty() ? this_thread::clear_affinity()
+                                                   : this_thread::set_affinity(AffinityCPUs[Index%AffinityCPUs.size()]);
+                if(Pinned)
+                    { PinnedGeneration = AffinityGeneration; }
+                else
+                    { AtomicAdd(&AffinityFailures,1); } // Tried again next frame
+            }
+
+            Resource& Storage = *Resources[Index];
+            if(!AffinityNodes.empty() && AffinityNodes[Index%AffinityNodes.size()]!=Storage.GetNumaNode() && !Storage.GetLocalWork().IsActive())
+            {
+                LogResources.Lock(); // The LogAggregator could be reading the committable logger
+                Storage.PlaceOnNode(AffinityNodes[Index%AffinityNodes.size()]);
+                LogResources.Unlock();
+            }
+        }
+
+        void FrameScheduler::UpdateDependentCounts()
+        {
+            DependentCounts.assign(DependentGraph.GetUnitCount(),0);
+            for(DependencyGraph::ConstIterator Iter=DependentGraph.OrderEnd(); Iter!=DependentGraph.OrderBegin(); )
+            {
+                Whole Current = *(--Iter); // Every dependent is counted before what it depends on
+                Whole Results = DependentGraph.GetDependentCount(Current);
+                for(DependencyGraph::ConstIterator Dependent=DependentGraph.DependentsBegin(Current); Dependent!=DependentGraph.DependentsEnd(Current); ++Dependent)
+                    { Results += DependentCounts[*Dependent]; }
+                DependentCounts[Current] = Results;
+            }
+
+            DependencyCounts.assign(DependentGraph.GetUnitCount(),0);
+            for(DependencyGraph::ConstIterator Iter=DependentGraph.OrderBegin(); Iter!=DependentGraph.OrderEnd(); ++Iter)
+            {
+                Whole Current = *Iter; // Every dependency is counted before what depends on it
+                Whole Results = 0;
+                for(DependencyGraph::ConstIterator Dependency=DependentGraph.DependenciesBegin(Current); Dependency!=DependentGraph.DependenciesEnd(Current); ++Dependency)
+                    { Results += 1 + DependencyCounts[*Dependency]; }
+                DependencyCounts[Current] = Results;
+            }
+        }
+
+        void FrameScheduler::UpdateCriticalPaths()
         {
-            // for each WorkUnit
-            for(std::vector<WorkUnitKey>::const_iterator Iter=Units.begin(); Iter!=Units.end(); ++Iter)
+            CriticalPaths.assign(DependentGraph.GetUnitCount(),0);
+            for(DependencyGraph::ConstIterator Iter=DependentGraph.OrderEnd(); Iter!=DependentGraph.OrderBegin(); )
             {
-                // For each Dependent of that Workunit
-                size_t Max = Iter->Unit->GetImmediateDependencyCount();
-                for(size_t Counter=0; Counter<Max; ++Counter)
-                    { DependentGraph[Iter->Unit->GetDependency(Counter)].insert(Iter->Unit); } // Make a record of the reverse association
+                Whole Current = *(--Iter);
+                Whole Longest = 0;
+                for(DependencyGraph::ConstIterator Dependent=DependentGraph.DependentsBegin(Current); Dependent!=DependentGraph.DependentsEnd(Current); ++Dependent)
+                {
+                    if(Longest<CriticalPaths[*Dependent])
+                        { Longest = CriticalPaths[*Dependent]; }
+                }
+                CriticalPaths[Current] = DependentGraph.GetUnit(Current)->GetPerformance() + Longest;
             }
         }
 
         void FrameScheduler::UpdateWorkUnitKeys(std::vector<WorkUnitKey> &Units)
         {
+            if(CriticalPathSorting)
+                { UpdateCriticalPaths(); } // Performance logs have changed since these were last calculated
             for(std::vector<WorkUnitKey>::iterator Iter=Units.begin(); Iter!=Units.end(); ++Iter)
                 { *Iter = Iter->Unit->GetSortingKey(*this); }
         }
 
+        void FrameScheduler::InvalidateReadiness()
+        {
+            ReadinessStale = true;
+            ReadyMain.clear();
+            ReadyMainCount = 0;
+            ReadyAffinity.clear();
+            PendingMonopolies = 0;
+        }
+
+        void FrameScheduler::UpdateReadiness()
+        {
+            UpdateDependentGraph();
+
+            InitialReadyMain.clear();
+            InitialReadyAffinity.clear();
+            InitialReadyMonopolies = 0;
+            Whole MainCount = DependentGraph.GetMainCount();
+            Whole ScheduledCount = DependentGraph.GetScheduledCount();
+            for(Whole Slot=0; Slot<ScheduledCount; ++Slot)
+            {
+                if(0==DependentGraph.GetScheduledDependencyCount(Slot))
+                {
+                    if(Slot<MainCount)
+                        { InitialReadyMain.push_back(Slot); }
+                    else
+                        { InitialReadyAffinity.push_back(Slot); } // Monopolies have the highest slots, so the main thread takes them first
+                    if(DependentGraph.IsMonopoly(Slot))
+                        { InitialReadyMonopolies++; }
+                }
+            }
+            std::make_heap(InitialReadyMain.begin(),InitialReadyMain.end());
+            std::make_heap(InitialReadyAffinity.begin(),InitialReadyAffinity.end());
+            UnitNodes.assign(MainCount,-1);
+            UpdateLookahead();
+            ReadinessStale = false;
+        }
+
+        void FrameScheduler::UpdateLookahead()
+        {
+            Whole MainCount = DependentGraph.GetMainCount();
+            AheadDependencyCounts.assign(MainCount,-1);
+            AheadStates.assign(MainCount,0);
+            CrossFrameSlots.clear();
+            if(PipelinedUnits.empty())
+                { return; }
+
+            for(DependencyGraph::ConstIterator Iter=DependentGraph.OrderBegin(); Iter!=DependentGraph.OrderEnd(); ++Iter)
+            {
+                Whole Current = *Iter; // Every dependency is visited before what depends on it
+                if(Current>=MainCount || PipelinedUnits.end()==std::find(PipelinedUnits.begin(),PipelinedUnits.end(),DependentGraph.GetUnit(Current))
+                   || 1<GetWorkUnitPeriod(DependentGraph.GetUnit(Current)) || IsWorkUnitOptional(DependentGraph.GetUnit(Current)))
+                    { continue; }
+                Int32 Count = 0;
+                for(DependencyGraph::ConstIterator Dependency=DependentGraph.DependenciesBegin(Current); Dependency!=DependentGraph.DependenciesEnd(Current); ++Dependency)
+                {
+                    if(*Dependency>=MainCount || -1==AheadDependencyCounts[*Dependency])
+                        { Count = -1; break; } // Waits on something that never starts early
+                    Count++;
+                }
+                AheadDependencyCounts[Current] = Count;
+            }
+
+            for(std::vector< std::pair<iWorkUnit*,iWorkUnit*> >::const_iterator Iter = CrossFrameDependencies.begin(); Iter!=CrossFrameDependencies.end(); ++Iter)
+            {
+                Whole Dependent = DependentGraph.GetIndexOf(Iter->first);
+                Whole Dependency = DependentGraph.GetIndexOf(Iter->second);
+                if(Dependent>=MainCount || -1==AheadDependencyCounts[Dependent] || Dependency>=DependentGraph.GetScheduledCount())
+                    { continue; } // Unscheduled WorkUnits never run, so they cannot be waited on
+                CrossFrameSlots.push_back(std::pair<Whole,Whole>(Dependency,Dependent));
+                AheadDependencyCounts[Dependent]++;
+            }
+            std::sort(CrossFrameSlots.begin(),CrossFrameSlots.end());
+        }
+
+        void FrameScheduler::PrepareLookahead()
+        {
+            LookaheadActive = false;
+            ReadyAhead.clear();
+            ReadyAheadCount = 0;
+            if(!FramePipelining)
+                { return; }
+            Whole MainCount = AheadDependencyCounts.size();
+            AheadRemaining.assign(MainCount,0);
+            for(Whole Slot=0; Slot<MainCount; ++Slot)
+            {
+                AheadStates[Slot] = 0;
+                if(-1==AheadDependencyCounts[Slot])
+                    { continue; }
+                LookaheadActive = true;
+                AheadRemaining[Slot] = AheadDependencyCounts[Slot] + (Complete==DependentGraph.GetUnit(Slot)->GetRunningState() ? 0 : 1);
+            }
+            for(std::vector< std::pair<Whole,Whole> >::const_iterator Iter = CrossFrameSlots.begin(); Iter!=CrossFrameSlots.end(); ++Iter)
+            {
+                if(Complete==DependentGraph.GetUnit(Iter->first)->GetRunningState())
+                    { AheadRemaining[Iter->second]--; }
+            }
+            for(Whole Slot=0; Slot<MainCount; ++Slot)
+            {
+                if(-1!=AheadDependencyCounts[Slot] && 0==AheadRemaining[Slot])
+                    { ReadyAhead.push_back(Slot); }
+            }
+            ReadyAheadCount = Int32(ReadyAhead.size());
+        }
+
+        void FrameScheduler::DecrementAhead(const Whole& Slot)
+        {
+            if(0==AtomicAdd(&AheadRemaining[Slot],-1)-1)
+            {
+                ReadyAheadLock.Lock();
+                ReadyAhead.push_back(Slot);
+                AtomicAdd(&ReadyAheadCount,1);
+                ReadyAheadLock.Unlock();
+            }
+        }
+
+        void FrameScheduler::UpdateStaggering()
+        {
+            std::vector<Whole> Periods;
+            for(std::vector<WorkUnitRate>::const_iterator Iter = WorkUnitRates.begin(); Iter!=WorkUnitRates.end(); ++Iter)
+            {
+                if(Iter->AutomaticPhase)
+                    { Periods.push_back(Iter->Period); }
+            }
+            std::sort(Periods.begin(),Periods.end());
+            Periods.erase(std::unique(Periods.begin(),Periods.end()), Periods.end());
+
+            for(std::vector<Whole>::const_iterator Period = Periods.begin(); Period!=Periods.end(); ++Period)
+            {
+                std::vector<MaxInt> Loads(*Period,0);
+                std::vector< std::pair<MaxInt,Whole> > Automatic; // The cost of each and where it is in WorkUnitRates
+                for(Whole Index = 0; Index<WorkUnitRates.size(); ++Index)
+                {
+                    if(WorkUnitRates[Index].Period!=*Period)
+                        { continue; }
+                    MaxInt Cost = MaxInt(WorkUnitRates[Index].Unit->GetPerformance())+1; // New WorkUnits are spread out by count
+                    if(WorkUnitRates[Index].AutomaticPhase)
+                        { Automatic.push_back(std::pair<MaxInt,Whole>(Cost,Index)); }
+                    else
+                        { Loads[WorkUnitRates[Index].Phase] += Cost; }
+                }
+                std::sort(Automatic.rbegin(),Automatic.rend()); // Slowest first, so the fast ones fill the gaps
+                for(std::vector< std::pair<MaxInt,Whole> >::const_iterator Iter = Automatic.begin(); Iter!=Automatic.end(); ++Iter)
+                {
+                    Whole Phase = std::min_element(Loads.begin(),Loads.end()) - Loads.begin();
+                    WorkUnitRates[Iter->second].Phase = Phase;
+                    Loads[Phase] += Iter->first;
+                }
+            }
+        }
+
+        bool FrameScheduler::SkipIdleWorkUnits(const Whole& Frame)
+        {
+            bool Skipped = false;
+            for(std::vector<WorkUnitRate>::const_iterator Iter = WorkUnitRates.begin(); Iter!=WorkUnitRates.end(); ++Iter)
+            {
+                if(Frame%Iter->Period!=Iter->Phase)
+                {
+                    Iter->Unit->MarkComplete();
+                    Skipped = true;
+                }
+            }
+            return Skipped;
+        }
+
+        bool FrameScheduler::ShedOptionalWorkUnits()
+        {
+            if(!TargetFrameLength || OptionalUnits.empty())
+                { return false; }
+
+            MaxInt Now = GetTimeStamp();
+            MaxInt Budget = MaxInt(TargetFrameLength) + TimingCostAllowance;
+            if(CurrentFrameStart+TargetFrameLength<Now)
+                { Budget -= Now-(CurrentFrameStart+TargetFrameLength); } // The next frame starts late
+            MaxInt Predicted = 0;
+            for(Whole Index = 0; Index<DependentGraph.GetScheduledCount(); ++Index)
+            {
+                if(Complete!=DependentGraph.GetUnit(Index)->GetRunningState())
+                    { Predicted += DependentGraph.GetUnit(Index)->GetPerformance(); }
+            }
+            Predicted /= CurrentThreadCount;
+
+            std::vector< std::pair<Integer,Whole> > Sheddable; // The effective priority of each and where it is in OptionalUnits
+            for(Whole Index = 0; Index<OptionalUnits.size(); ++Index)
+            {
+                if(Complete!=OptionalUnits[Index].Unit->GetRunningState())
+                    { Sheddable.push_back(std::pair<Integer,Whole>(OptionalUnits[Index].Priority+Integer(OptionalUnits[Index].FramesShed),Index)); }
+            }
+            std::sort(Sheddable.begin(),Sheddable.end());
+
+            bool Shed = false;
+            for(std::vector< std::pair<Integer,Whole> >::const_iterator Iter = Sheddable.begin(); Iter!=Sheddable.end(); ++Iter)
+            {
+                OptionalWorkUnit& Optional = OptionalUnits[Iter->second];
+                if(Predicted<=Budget)
+                {
+                    Optional.FramesShed = 0;
+                    continue;
+                }
+                Predicted -= Optional.Unit->GetPerformance()/CurrentThreadCount;
+                Optional.Unit->MarkComplete();
+                Optional.FramesShed++;
+                ShedCount++;
+                Shed = true;
+            }
+            return Shed;
+        }
+
+        void FrameScheduler::ForgetWorkUnit(iWorkUnit* Unit)
+        {
+            PipelinedUnits.erase(std::remove(PipelinedUnits.begin(),PipelinedUnits.end(),Unit), PipelinedUnits.end());
+            for(std::vector< std::pair<iWorkUnit*,iWorkUnit*> >::iterator Iter = CrossFrameDependencies.begin(); Iter!=CrossFrameDependencies.end(); )
+            {
+                if(Iter->first==Unit || Iter->second==Unit)
+                    { Iter = CrossFrameDependencies.erase(Iter); }
+                else
+                    { ++Iter; }
+            }
+            for(std::vector<WorkUnitRate>::iterator Iter = WorkUnitRates.begin(); Iter!=WorkUnitRates.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                {
+                    WorkUnitRates.erase(Iter);
+                    UpdateStaggering();
+                    break;
+                }
+            }
+            SetWorkUnitMandatory(Unit);
+        }
+
+        void FrameScheduler::SeedReadyWorkUnits()
+        {
+            Whole ScheduledCount = DependentGraph.GetScheduledCount();
+            OutstandingWork = ScheduledCount;
+            for(Whole Slot=0; Slot<ScheduledCount; ++Slot)
+            {
+                iWorkUnit* Unit = DependentGraph.GetUnit(Slot);
+                if(Complete==Unit->GetRunningState())
+                {
+                    Unit->SetRemainingDependencyCount(DependentGraph.GetScheduledDependencyCount(Slot)); // Ready for next frame
+                    OutstandingWork--;
+                }else{
+                    Unit->SetRemainingDependencyCount(0);
+                }
+            }
+            for(Whole Slot=0; Slot<ScheduledCount; ++Slot) // Unscheduled units are never waited on
+            {
+                if(Complete==DependentGraph.GetUnit(Slot)->GetRunningState())
+                    { continue; }
+                for(DependencyGraph::ConstIterator Iter=DependentGraph.DependentsBegin(Slot); Iter!=DependentGraph.DependentsEnd(Slot); ++Iter)
+                {
+                    iWorkUnit* Dependent = DependentGraph.GetUnit(*Iter);
+                    Dependent->SetRemainingDependencyCount(Dependent->GetRemainingDependencyCount()+1);
+                }
+            }
+
+            ReadyMain.clear();
+            ReadyAffinity.clear();
+            PendingMonopolies = 0;
+            Whole MainCount = DependentGraph.GetMainCount();
+            for(Whole Slot=0; Slot<ScheduledCount; ++Slot)
+            {
+                iWorkUnit* Unit = DependentGraph.GetUnit(Slot);
+                if(NotStarted==Unit->GetRunningState() && 0==Unit->GetRemainingDependencyCount())
+                {
+                    if(Slot<MainCount)
+                        { ReadyMain.push_back(Slot); }
+                    else
+                        { ReadyAffinity.push_back(Slot); }
+                    if(DependentGraph.IsMonopoly(Slot))
+                        { PendingMonopolies++; }
+                }
+            }
+            std::make_heap(ReadyMain.begin(),ReadyMain.end());
+            std::make_heap(ReadyAffinity.begin(),ReadyAffinity.end());
+            ReadyMainCount = Int32(ReadyMain.size());
+        }
+
+        Whole FrameScheduler::UpdateDeferredSlots()
+        {
+            Whole ScheduledCount = DependentGraph.GetScheduledCount();
+            DeferredSlots.assign(ScheduledCount,0);
+            if(ReadinessStale)
+                { return 0; } // Nothing is released or counted down from a stale graph either
+            Whole Deferred = 0;
+            std::vector<Whole> Unvisited;
+            for(std::vector<iAsynchronousWorkUnit*>::iterator Iter = PendingAsynchronous.begin(); Iter!=PendingAsynchronous.end(); ++Iter)
+            {
+                Whole Index = DependentGraph.GetIndexOf(*Iter);
+                if(DependencyGraph::NotFound!=Index && Index<ScheduledCount)
+                    { Unvisited.push_back(Index); }
+            }
+            while(!Unvisited.empty())
+            {
+                Whole Slot = Unvisited.back();
+                Unvisited.pop_back();
+                if(DeferredSlots[Slot])
+                    { continue; }
+                DeferredSlots[Slot] = 1;
+                Deferred++;
+                for(DependencyGraph::ConstIterator Iter=DependentGraph.DependentsBegin(Slot); Iter!=DependentGraph.DependentsEnd(Slot); ++Iter)
+                {
+                    if(*Iter<ScheduledCount && !DeferredSlots[*Iter])
+                        { Unvisited.push_back(*Iter); }
+                }
+            }
+            return Deferred;
+        }
+
+        void FrameScheduler::PublishReadySlot(const Whole& Slot)
+        {
+            if(Slot<DependentGraph.GetMainCount())
+            {
+                ReadyMainLock.Lock();
+                ReadyMain.push_back(Slot);
+                std::push_heap(ReadyMain.begin(),ReadyMain.end());
+                AtomicAdd(&ReadyMainCount,1);
+                ReadyMainLock.Unlock();
+            }else{
+                if(DependentGraph.IsMonopoly(Slot))
+                    { AtomicAdd(&PendingMonopolies,1); } // Before it can be found, so no other WorkUnit starts after it is ready
+                ReadyAffinityLock.Lock();
+                ReadyAffinity.push_back(Slot);
+                std::push_heap(ReadyAffinity.begin(),ReadyAffinity.end());
+                ReadyAffinityLock.Unlock();
+            }
+        }
+
+        void FrameScheduler::DistributeReadyWorkUnits()
+        {
+            std::vector<Whole> Active;
+            for(Whole Count = 0; Count<Resources.size(); ++Count)
+            {
+                bool Placing = !AffinityNodes.empty() && AffinityNodes[Count%AffinityNodes.size()]!=Resources[Count]->GetNumaNode();
+                if(Count<CurrentThreadCount && !Placing) // A thread moving its resources to another node sits out one frame of stealing
+                {
+                    Resources[Count]->GetLocalWork().Reset(DependentGraph.GetScheduledCount());
+                    Active.push_back(Count);
+                }else{
+                    Resources[Count]->GetLocalWork().Deactivate();
+                }
+            }
+
+            Whole ThreadCount = Active.size();
+            if(!ThreadCount)
+                { return; }
+            std::sort_heap(ReadyMain.begin(),ReadyMain.end()); // Lowest priority first
+            Whole ReadyCount = ReadyMain.size();
+            for(Whole Count = 0; Count<ReadyCount; ++Count) // Each deque gets its lowest priority work first so it is popped last
+            {
+                Whole Target = Active[(ReadyCount-1-Count)%ThreadCount];
+                Int32 Node = 1<AffinityNodeCount ? UnitNodes[ReadyMain[Count]] : -1;
+                for(Whole Offset = 0; -1!=Node && Offset<ThreadCount; ++Offset) // Prefer a thread on the node this last ran on
+                {
+                    Whole Candidate = Active[(ReadyCount-1-Count+Offset)%ThreadCount];
+                    if(Node==Resources[Candidate]->GetNumaNode())
+                    {
+                        Target = Candidate;
+                        break;
+                    }
+                }
+                Resources[Target]->GetLocalWork().Push(ReadyMain[Count]);
+            }
+            ReadyMain.clear();
+            ReadyMainCount = 0;
+        }
+
+        iWorkUnit* FrameScheduler::StealWorkUnit(Resource& Thief)
+        {
+            WorkStealingDeque& Local = Thief.GetLocalWork();
+            Whole VictimCount = Resources.size();
+            Int32 ThiefNode = Thief.GetNumaNode();
+            Whole Passes = (1<AffinityNodeCount && -1!=ThiefNode) ? 2 : 1; // Victims on the thief's node are tried first
+            for(Whole Pass = 0; Pass<Passes; ++Pass)
+            {
+                for(Whole Attempt = 0; Attempt<VictimCount; ++Attempt)
+                {
+                    Whole Victim = (Local.GetNextVictim()+Attempt) % VictimCount;
+                    WorkStealingDeque& Target = Resources[Victim]->GetLocalWork();
+                    if(&Target==&Local || !Target.IsActive())
+                        { continue; }
+                    if(1<Passes && (0==Pass)!=(ThiefNode==Resources[Victim]->GetNumaNode()))
+                        { continue; }
+
+                    Int32 Slot = Target.Steal();
+                    if(WorkStealingDeque::Empty!=Slot && NotStarted==DependentGraph.GetUnit(Slot)->GetRunningState())
+                    {
+                        Local.SetNextVictim(Victim); // A productive victim likely has more
+                        UnitNodes[Slot] = ThiefNode;
+                        return DependentGraph.GetUnit(Slot);
+                    }
+                }
+            }
+            return 0;
+        }
+
+        const Whole FrameScheduler::AutomaticPhase = Whole(-1);
+
         ////////////////////////////////////////////////////////////////////////////////
         // Construction and Destruction
-        FrameScheduler::FrameScheduler(std::fstream *_LogDestination, Whole StartingThreadCount) :
+        FrameScheduler::FrameScheduler(std::fstream *_LogDestination, Whole StartingThreadCount, BarrierAlgorithm FrameBarriers) :
             FrameTimeLog(MEZZ_FRAMESTOTRACK),
             PauseTimeLog(MEZZ_FRAMESTOTRACK),
             CurrentFrameStart(GetTimeStamp()),
@@ -171,17 +804,62 @@ namespace Mezzanine
             LogDestination(_LogDestination ? _LogDestination : new std::fstream("Mezzanine.log", std::ios::out | std::ios::trunc)),
             Sorter(0),
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-            StartFrameSync(StartingThreadCount),
-            EndFrameSync(StartingThreadCount),
+            StartFrameSync(CombiningTreeBarrier==FrameBarriers ? new TreeBarrier(1) : new Barrier(1)),
+            EndFrameSync(CombiningTreeBarrier==FrameBarriers ? new TreeBarrier(1) : new Barrier(1)),
             LastFrame(0),
+            SyncedThreadCount(1),
             #endif
-            #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-            DecacheMain(0),
-            DecacheAffinity(0),
+            #ifdef MEZZ_USETHREADPOOL
+            PoolFrame(0),
+            PoolWorking(0),
+            PoolSize(1),
+            PoolBackground(0),
             #endif
+            ReadyMainCount(0),
+            ReadinessStale(true),
+            InitialReadyMonopolies(0),
+            PendingMonopolies(0),
+            OutstandingWork(0),
+            IdleSpinCount(256),
+            IdleYieldCount(8),
+            ParkedThreads(0),
+            ParkCount(0),
+            FrameEpoch(0),
+            WorkStealing(false),
+            CriticalPathSorting(false),
+            FramePipelining(false),
+            ReadyAheadCount(0),
+            LookaheadActive(false),
+            AheadRunCount(0),
+            ShedCount(0),
+            BackgroundDeadline(0),
+            BackgroundCursor(0),
+            BackgroundRunCount(0),
+            ForkedTaskCount(0),
+            ResumesPending(0),
+            CompletionWaiterCount(0),
+            TimedWaiterCount(0),
+            DeferredCount(0),
+            AsynchronousDeferred(false),
+            Timers(GetTimeStamp()),
+            TimersPending(0),
+            TimerExpiryCount(0),
+            FrameBarrierAlgorithm(FrameBarriers),
             CurrentThreadCount(StartingThreadCount),
+            AdaptiveThreadCount(false),
+            MinimumThreadCount(1),
+            MaximumThreadCount(GetCPUCount()),
+            FramesWithSpareThreads(0),
+            IdleTime(0),
+            AffinityPolicy(NoAffinity),
+            AffinityNodeCount(0),
+            AffinityGeneration(0),
+            MainAffinityGeneration(0),
+            AffinityFailures(0),
             FrameCount(0), TargetFrameLength(16666),
             TimingCostAllowance(0),
+            MaximumFrameWait(MEZZ_MAXFRAMEWAIT),
+            PacingMargin(MEZZ_MAXPACINGMARGIN/10),
             MainThreadID(this_thread::get_id()),
             LoggingToAnOwnedFileStream(true),
             NeedToLogDeps(true)
@@ -190,7 +868,7 @@ namespace Mezzanine
             GetLog() << "<MezzanineLog>" << std::endl;
         }
 
-        FrameScheduler::FrameScheduler(std::ostream *_LogDestination, Whole StartingThreadCount) :
+        FrameScheduler::FrameScheduler(std::ostream *_LogDestination, Whole StartingThreadCount, BarrierAlgorithm FrameBarriers) :
             FrameTimeLog(MEZZ_FRAMESTOTRACK),
             PauseTimeLog(MEZZ_FRAMESTOTRACK),
             CurrentFrameStart(GetTimeStamp()),
@@ -198,17 +876,62 @@ namespace Mezzanine
             LogDestination(_LogDestination),
             Sorter(0),
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-            StartFrameSync(StartingThreadCount),
-            EndFrameSync(StartingThreadCount),
+            StartFrameSync(CombiningTreeBarrier==FrameBarriers ? new TreeBarrier(1) : new Barrier(1)),
+            EndFrameSync(CombiningTreeBarrier==FrameBarriers ? new TreeBarrier(1) : new Barrier(1)),
             LastFrame(0),
+            SyncedThreadCount(1),
             #endif
-            #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-            DecacheMain(0),
-            DecacheAffinity(0),
+            #ifdef MEZZ_USETHREADPOOL
+            PoolFrame(0),
+            PoolWorking(0),
+            PoolSize(1),
+            PoolBackground(0),
             #endif
+            ReadyMainCount(0),
+            ReadinessStale(true),
+            InitialReadyMonopolies(0),
+            PendingMonopolies(0),
+            OutstandingWork(0),
+            IdleSpinCount(256),
+            IdleYieldCount(8),
+            ParkedThreads(0),
+            ParkCount(0),
+            FrameEpoch(0),
+            WorkStealing(false),
+            CriticalPathSorting(false),
+            FramePipelining(false),
+            ReadyAheadCount(0),
+            LookaheadActive(false),
+            AheadRunCount(0),
+            ShedCount(0),
+            BackgroundDeadline(0),
+            BackgroundCursor(0),
+            BackgroundRunCount(0),
+            ForkedTaskCount(0),
+            ResumesPending(0),
+            CompletionWaiterCount(0),
+            TimedWaiterCount(0),
+            DeferredCount(0),
+            AsynchronousDeferred(false),
+            Timers(GetTimeStamp()),
+            TimersPending(0),
+            TimerExpiryCount(0),
+            FrameBarrierAlgorithm(FrameBarriers),
             CurrentThreadCount(StartingThreadCount),
+            AdaptiveThreadCount(false),
+            MinimumThreadCount(1),
+            MaximumThreadCount(GetCPUCount()),
+            FramesWithSpareThreads(0),
+            IdleTime(0),
+            AffinityPolicy(NoAffinity),
+            AffinityNodeCount(0),
+            AffinityGeneration(0),
+            MainAffinityGeneration(0),
+            AffinityFailures(0),
             FrameCount(0), TargetFrameLength(16666),
             TimingCostAllowance(0),
+            MaximumFrameWait(MEZZ_MAXFRAMEWAIT),
+            PacingMargin(MEZZ_MAXPACINGMARGIN/10),
             MainThreadID(this_thread::get_id()),
             LoggingToAnOwnedFileStream(false),
             NeedToLogDeps(true)
@@ -232,11 +955,19 @@ namespace Mezzanine
             }
             for(std::vector<WorkUnitKey>::iterator Iter=WorkUnitsMain.begin(); Iter!=WorkUnitsMain.end(); ++Iter)
                 { delete Iter->Unit; }
+            for(std::vector<WorkUnitKey>::iterator Iter=WorkUnitsAffinity.begin(); Iter!=WorkUnitsAffinity.end(); ++Iter)
+                { Iter->Unit->UseFrameEpoch(0); } // These outlive this scheduler and its epoch
             for(std::vector<MonopolyWorkUnit*>::iterator Iter = WorkUnitsMonopolies.begin(); Iter!=WorkUnitsMonopolies.end(); ++Iter)
                 { delete *Iter; }
+            for(std::vector<iWorkUnit*>::iterator Iter = WorkUnitsBackground.begin(); Iter!=WorkUnitsBackground.end(); ++Iter)
+                { delete *Iter; }
             for(std::vector<DefaultThreadSpecificStorage::Type*>::iterator Iter = Resources.begin(); Iter!=Resources.end(); ++Iter)
                 { delete *Iter; }
             DeleteThreads();
+            #ifdef MEZZ_USEBARRIERSEACHFRAME
+            delete StartFrameSync;
+            delete EndFrameSync;
+            #endif
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -244,6 +975,8 @@ namespace Mezzanine
         void FrameScheduler::AddWorkUnitMain(iWorkUnit* MoreWork, const String& WorkUnitName)
         {
             DependenciesChanged();
+            if(!MoreWork->UseFrameEpoch(&FrameEpoch))
+                { WorkUnitsWithoutEpoch.push_back(MoreWork); }
             this->WorkUnitsMain.push_back(MoreWork->GetSortingKey(*this));
             (*this->LogDestination) << "<WorkUnitMainInsertion ID=\"" << hex << MoreWork << "\" Name=\"" << WorkUnitName << "\" />" << endl;
         }
@@ -251,6 +984,8 @@ namespace Mezzanine
         void FrameScheduler::AddWorkUnitAffinity(iWorkUnit* MoreWork, const String& WorkUnitName)
         {
             DependenciesChanged();
+            if(!MoreWork->UseFrameEpoch(&FrameEpoch))
+                { WorkUnitsWithoutEpoch.push_back(MoreWork); }
             this->WorkUnitsAffinity.push_back(MoreWork->GetSortingKey(*this));
             (*this->LogDestination) << "<WorkUnitAffinityInsertion ID=\"" << hex << MoreWork << "\" Name=\"" << WorkUnitName << "\" />" << endl;
         }
@@ -258,10 +993,19 @@ namespace Mezzanine
         void FrameScheduler::AddWorkUnitMonopoly(MonopolyWorkUnit* MoreWork, const String& WorkUnitName)
         {
             DependenciesChanged();
+            if(!MoreWork->UseFrameEpoch(&FrameEpoch))
+                { WorkUnitsWithoutEpoch.push_back(MoreWork); }
             this->WorkUnitsMonopolies.push_back(MoreWork);
             (*this->LogDestination) << "<WorkUnitMonopolyInsertion ID=\"" << hex << MoreWork << "\" Name=\"" << WorkUnitName << "\" />" << endl;
         }
 
+        void FrameScheduler::AddWorkUnitBackground(iWorkUnit* MoreWork, const String& WorkUnitName)
+        {
+            this->WorkUnitsBackground.push_back(MoreWork);
+            this->BackgroundBusy.push_back(0);
+            (*this->LogDestination) << "<WorkUnitBackgroundInsertion ID=\"" << hex << MoreWork << "\" Name=\"" << WorkUnitName << "\" />" << endl;
+        }
+
         void FrameScheduler::SortWorkUnitsMain(bool UpdateDependentGraph_)
         {
             if(UpdateDependentGraph_)
@@ -271,6 +1015,8 @@ namespace Mezzanine
                 UpdateWorkUnitKeys(WorkUnitsMain);
                 std::sort(WorkUnitsMain.begin(),WorkUnitsMain.end(),std::less<WorkUnitKey>() );
             }
+            UpdateReadiness();
+            SeedReadyWorkUnits();
         }
 
         void FrameScheduler::SortWorkUnitsAffinity(bool UpdateDependentGraph_)
@@ -282,6 +1028,8 @@ namespace Mezzanine
                 UpdateWorkUnitKeys(WorkUnitsAffinity);
                 std::sort(WorkUnitsAffinity.begin(),WorkUnitsAffinity.end(),std::less<WorkUnitKey>() );
             }
+            UpdateReadiness();
+            SeedReadyWorkUnits();
         }
 
         void FrameScheduler::SortWorkUnitsAll(bool UpdateDependentGraph_)
@@ -292,6 +1040,10 @@ namespace Mezzanine
 
         void FrameScheduler::RemoveWorkUnitMain(iWorkUnit* LessWork)
         {
+            InvalidateReadiness();
+            ForgetWorkUnit(LessWork);
+            LessWork->UseFrameEpoch(0);
+            WorkUnitsWithoutEpoch.erase(std::remove(WorkUnitsWithoutEpoch.begin(),WorkUnitsWithoutEpoch.end(),LessWork), WorkUnitsWithoutEpoch.end());
             if(WorkUnitsMain.size())
             {
                 IteratorMain RemovalTarget = WorkUnitsMain.end();
@@ -318,6 +1070,10 @@ namespace Mezzanine
 
         void FrameScheduler::RemoveWorkUnitAffinity(iWorkUnit* LessWork)
         {
+            InvalidateReadiness();
+            ForgetWorkUnit(LessWork);
+            LessWork->UseFrameEpoch(0);
+            WorkUnitsWithoutEpoch.erase(std::remove(WorkUnitsWithoutEpoch.begin(),WorkUnitsWithoutEpoch.end(),LessWork), WorkUnitsWithoutEpoch.end());
             if(WorkUnitsAffinity.size())
             {
                 IteratorAffinity RemovalTarget = WorkUnitsMain.end();
@@ -344,6 +1100,10 @@ namespace Mezzanine
 
         void FrameScheduler::RemoveWorkUnitMonopoly(MonopolyWorkUnit* LessWork)
         {
+            InvalidateReadiness();
+            ForgetWorkUnit(LessWork);
+            LessWork->UseFrameEpoch(0);
+            WorkUnitsWithoutEpoch.erase(std::remove(WorkUnitsWithoutEpoch.begin(),WorkUnitsWithoutEpoch.end(),LessWork), WorkUnitsWithoutEpoch.end());
             if(WorkUnitsMain.size())
             {
                 for(IteratorMain Iter = WorkUnitsMain.begin(); Iter!=WorkUnitsMain.end(); Iter++)
@@ -367,94 +1127,175 @@ namespace Mezzanine
             }
         }
 
-        ////////////////////////////////////////////////////////////////////////////////
-        // Algorithm essentials
-
-        Whole FrameScheduler::GetDependentCountOf(iWorkUnit* Work, bool UsedCachedDepedentGraph)
+        void FrameScheduler::RemoveWorkUnitBackground(iWorkUnit* LessWork)
         {
-            if(UsedCachedDepedentGraph)
-                { UpdateDependentGraph(); }
-            Whole Results = DependentGraph[Work].size();
-            for(std::set<iWorkUnit*>::iterator Iter=DependentGraph[Work].begin(); Iter!=DependentGraph[Work].end(); ++Iter)
+            for(Whole Slot = 0; Slot<WorkUnitsBackground.size(); ++Slot)
             {
-                Results+=GetDependentCountOf(*Iter);
+                if(WorkUnitsBackground[Slot]==LessWork)
+                {
+                    WorkUnitsBackground.erase(WorkUnitsBackground.begin()+Slot);
+                    BackgroundBusy.erase(BackgroundBusy.begin()+Slot);
+                    return;
+                }
             }
-            return Results;
         }
-        //DecacheMain(0),
-        //DecacheAffinity(0),
-        iWorkUnit* FrameScheduler::GetNextWorkUnit()
+
+        Int32 FrameScheduler::GetBackgroundRunCount() const
+            { return AtomicAdd(const_cast<Int32*>(&BackgroundRunCount),0); }
+
+        TimerHandle FrameScheduler::AddTimer(ForkedFunction Function, void* Argument, const MaxInt& Delay, const MaxInt& Period)
         {
-            #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-            bool CompleteSoFar = true;
-            Int32 CurrentRun = DecacheMain;
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsMain.rbegin()+CurrentRun; Iter!=WorkUnitsMain.rend(); ++Iter)
-            {
-                if (NotStarted==Iter->Unit->GetRunningState())
-                {
-                    if(Iter->Unit->IsEveryDependencyComplete())
-                        { return Iter->Unit; }
-                    CompleteSoFar=false;
-                }
+            MaxInt ExpiryTime = GetTimeStamp()+Delay;
+            TimersLock.Lock();
+            TimerHandle Result = Timers.Add(Function,Argument,ExpiryTime,Period);
+            TimersLock.Unlock();
+            return Result;
+        }
 
-                if(CompleteSoFar)
-                {
-                    CurrentRun++;
-                    if(Complete==Iter->Unit->GetRunningState())
-                        { AtomicCompareAndSwap32(&DecacheMain,DecacheMain,CurrentRun); }
-                }
-            }
-            #else
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsMain.rbegin(); Iter!=WorkUnitsMain.rend(); ++Iter)
-            {
-                if (NotStarted==Iter->Unit->GetRunningState())
-                {
-                    if(Iter->Unit->IsEveryDependencyComplete())
-                        { return Iter->Unit; }
-                }
-            }
-            #endif
+        bool FrameScheduler::CancelTimer(TimerHandle Timer)
+        {
+            TimersLock.Lock();
+            bool Result = Timers.Cancel(Timer);
+            TimersLock.Unlock();
+            return Result;
+        }
 
-            return 0;
+        bool FrameScheduler::IsTimerWaiting(TimerHandle Timer)
+        {
+            TimersLock.Lock();
+            bool Result = Timers.IsWaiting(Timer);
+            TimersLock.Unlock();
+            return Result;
         }
 
-        iWorkUnit* FrameScheduler::GetNextWorkUnitAffinity()
+        Whole FrameScheduler::GetTimerCount()
         {
-            #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-            bool CompleteSoFar = true;
-            Int32 CurrentRun = DecacheAffinity;
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsAffinity.rbegin()+CurrentRun; Iter!=WorkUnitsAffinity.rend(); ++Iter)
-            {
-                if (NotStarted==Iter->Unit->GetRunningState())
-                {
-                    if(Iter->Unit->IsEveryDependencyComplete())
-                        { return Iter->Unit; }
-                    CompleteSoFar=false;
-                }
+            TimersLock.Lock();
+            Whole Result = Timers.GetCount();
+            TimersLock.Unlock();
+            return Result;
+        }
 
-                if(CompleteSoFar)
-                {
-                    CurrentRun++;
-                    if(Complete==Iter->Unit->GetRunningState())
-                        { AtomicCompareAndSwap32(&DecacheAffinity,DecacheAffinity,CurrentRun); }
-                }
+        Int32 FrameScheduler::GetTimerExpiryCount() const
+            { return AtomicAdd(const_cast<Int32*>(&TimerExpiryCount),0); }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // Algorithm essentials
+
+        Whole FrameScheduler::GetDependentCountOf(iWorkUnit* Work, bool UsedCachedDepedentGraph)
+        {
+            if(UsedCachedDepedentGraph)
+                { UpdateDependentGraph(); }
+            Whole Index = DependentGraph.GetIndexOf(Work);
+            if(DependencyGraph::NotFound==Index || Index>=DependentCounts.size())
+                { return 0; }
+            return DependentCounts[Index];
+        }
+
+        Whole FrameScheduler::GetDependencyCountOf(iWorkUnit* Work, bool UsedCachedDepedentGraph)
+        {
+            if(UsedCachedDepedentGraph)
+                { UpdateDependentGraph(); }
+            Whole Index = DependentGraph.GetIndexOf(Work);
+            if(DependencyGraph::NotFound==Index || Index>=DependencyCounts.size())
+                { return 0; }
+            return DependencyCounts[Index];
+        }
+
+        Whole FrameScheduler::GetCriticalPathOf(iWorkUnit* Work)
+        {
+            Whole Index = DependentGraph.GetIndexOf(Work);
+            if(DependencyGraph::NotFound==Index || Index>=CriticalPaths.size())
+                { return 0; }
+            return CriticalPaths[Index];
+        }
+
+        iWorkUnit* FrameScheduler::GetNextWorkUnit()
+        {
+            iWorkUnit* Results = 0;
+            ReadyMainLock.Lock();
+            while(!Results && ReadyMain.size())
+            {
+                std::pop_heap(ReadyMain.begin(),ReadyMain.end()); // Highest slot, and therefore priority, goes to the back
+                Results = DependentGraph.GetUnit(ReadyMain.back());
+                ReadyMain.pop_back();
+                AtomicAdd(&ReadyMainCount,-1);
+                if(NotStarted!=Results->GetRunningState())
+                    { Results = 0; }
             }
-            #else
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsAffinity.rbegin(); Iter!=WorkUnitsAffinity.rend(); ++Iter)
+            ReadyMainLock.Unlock();
+            return Results;
+        }
+
+        iWorkUnit* FrameScheduler::GetNextWorkUnit(Resource& CurrentThread)
+        {
+            if(0<AtomicLoad(&PendingMonopolies))
+                { return 0; } // Threads wait in the Monopoly's team instead
+            WorkStealingDeque& Local = CurrentThread.GetLocalWork();
+            if(!WorkStealing || !Local.IsActive())
+                { return GetNextWorkUnit(); }
+
+            for(Int32 Slot = Local.Pop(); WorkStealingDeque::Empty!=Slot; Slot = Local.Pop())
             {
-                if (NotStarted==Iter->Unit->GetRunningState())
+                if(NotStarted==DependentGraph.GetUnit(Slot)->GetRunningState())
                 {
-                    if(Iter->Unit->IsEveryDependencyComplete())
-                        { return Iter->Unit; }
+                    UnitNodes[Slot] = CurrentThread.GetNumaNode();
+                    return DependentGraph.GetUnit(Slot);
                 }
             }
-            #endif
 
+            if(0<AtomicLoad(&ReadyMainCount)) // Only work released by threads without a deque lands here, so avoid the lock when possible
+            {
+                iWorkUnit* Results = GetNextWorkUnit();
+                if(Results)
+                    { return Results; }
+            }
+            return StealWorkUnit(CurrentThread);
+        }
+
+        iWorkUnit* FrameScheduler::GetNextWorkUnitAffinity()
+        {
+            iWorkUnit* Results = 0;
+            ReadyAffinityLock.Lock();
+            while(!Results && ReadyAffinity.size())
+            {
+                std::pop_heap(ReadyAffinity.begin(),ReadyAffinity.end());
+                Results = DependentGraph.GetUnit(ReadyAffinity.back());
+                ReadyAffinity.pop_back();
+                if(NotStarted!=Results->GetRunningState())
+                    { Results = 0; }
+            }
+            ReadyAffinityLock.Unlock();
+
+            if(Results)
+                { return Results; }
             return GetNextWorkUnit();
         }
 
+        iWorkUnit* FrameScheduler::GetNextWorkUnitAffinity(Resource& CurrentThread)
+        {
+            iWorkUnit* Results = 0;
+            ReadyAffinityLock.Lock();
+            while(!Results && ReadyAffinity.size())
+            {
+                std::pop_heap(ReadyAffinity.begin(),ReadyAffinity.end());
+                Results = DependentGraph.GetUnit(ReadyAffinity.back());
+                ReadyAffinity.pop_back();
+                if(NotStarted!=Results->GetRunningState())
+                    { Results = 0; }
+            }
+            ReadyAffinityLock.Unlock();
+
+            if(Results)
+                { return Results; }
+            return GetNextWorkUnit(CurrentThread);
+        }
+
         bool FrameScheduler::AreAllWorkUnitsComplete()
         {
+            if(!ReadinessStale)
+                { return 0>=GetOutstandingWorkUnitCount(); }
+
             // start reading from units likely to be executed last.
             for(IteratorMain Iter = WorkUnitsMain.begin(); Iter!=WorkUnitsMain.end(); ++Iter)
             {
@@ -468,14 +1309,341 @@ namespace Mezzanine
                     { return false; }
             }
 
+            for(IteratorMonoply Iter = WorkUnitsMonopolies.begin(); Iter!=WorkUnitsMonopolies.end(); ++Iter)
+            {
+                if(Complete!=(*Iter)->GetRunningState())
+                    { return false; }
+            }
+
+            return true;
+        }
+
+        Int32 FrameScheduler::GetOutstandingWorkUnitCount() const
+            { return AtomicAdd(const_cast<Int32*>(&OutstandingWork),0); }
+
+        Int32 FrameScheduler::WaitForWorkUnitCompletion(const Int32& Outstanding) const
+        {
+            Int32 Current = GetOutstandingWorkUnitCount();
+            MaxInt IdleStart = (AdaptiveThreadCount && Current==Outstanding) ? GetTimeStamp() : 0;
+            for(Whole Spins = 0; Current==Outstanding && 0<Current && Spins<IdleSpinCount; ++Spins)
+                { Current = GetOutstandingWorkUnitCount(); }
+            for(Whole Yields = 0; Current==Outstanding && 0<Current && Yields<IdleYieldCount; ++Yields)
+            {
+                this_thread::yield();
+                Current = GetOutstandingWorkUnitCount();
+            }
+            while(Current==Outstanding && 0<Current)
+            {
+                MaxInt Timeout = 0;
+                if(0<AtomicAdd(const_cast<Int32*>(&TimedWaiterCount),0)) // Nothing wakes parked threads when these are due
+                {
+                    MaxInt Now = GetTimeStamp();
+                    MaxInt Due = GetNextResumeTime();
+                    if(Due<=Now)
+                        { break; } // Return so this thread wakes it
+                    Timeout = Due-Now;
+                }
+                AtomicAdd(&ParkedThreads,1); // Counted before the value is checked again, so a completion either sees this or changes the value first
+                AtomicAdd(&ParkCount,1);
+                if(Timeout)
+                    { AtomicWaitFor(const_cast<Int32*>(&OutstandingWork),Current,Whole(Timeout)); }
+                else
+                    { AtomicWait(const_cast<Int32*>(&OutstandingWork),Current); }
+                AtomicAdd(&ParkedThreads,-1);
+                Current = GetOutstandingWorkUnitCount();
+            }
+            if(IdleStart)
+                { AtomicAdd(&IdleTime,Int32(GetTimeStamp()-IdleStart)); }
+            return Current;
+        }
+
+        void FrameScheduler::WaitForAllWorkUnits() const
+        {
+            for(Int32 Outstanding = GetOutstandingWorkUnitCount(); 0<Outstanding; )
+                { Outstanding = WaitForWorkUnitCompletion(Outstanding); }
+        }
+
+        bool FrameScheduler::RunWorkUnitAhead(Resource& CurrentThread)
+        {
+            if(!LookaheadActive || 0>=AtomicLoad(&ReadyAheadCount) || 0<AtomicLoad(&PendingMonopolies) || 0>=GetOutstandingWorkUnitCount())
+                { return false; } // Work from the next frame only fills idle time, it should not delay the end of this one
+            ReadyAheadLock.Lock();
+            if(ReadyAhead.empty())
+            {
+                ReadyAheadLock.Unlock();
+                return false;
+            }
+            Whole Slot = ReadyAhead.back();
+            ReadyAhead.pop_back();
+            AtomicAdd(&ReadyAheadCount,-1);
+            ReadyAheadLock.Unlock();
+
+            AheadStates[Slot] = 1; // Each slot is published once a frame, so only this thread changes this until the frame ends
+            DependentGraph.GetUnit(Slot)->operator()(CurrentThread);
+            return true;
+        }
+
+        void FrameScheduler::ForkTask(ForkedFunction Function, void* Argument, Int32& Pending)
+        {
+            ForkedTask Task;
+            Task.Function = Function;
+            Task.Argument = Argument;
+            Task.Pending = &Pending;
+            AtomicAdd(&Pending,1);
+            ForkedTasksLock.Lock();
+            ForkedTasks.push_back(Task);
+            AtomicAdd(&ForkedTaskCount,1);
+            ForkedTasksLock.Unlock();
+            AtomicAdd(&OutstandingWork,1); // Only after publishing, so a thread seeing this change can find the task
+            if(0<AtomicAdd(&ParkedThreads,0))
+                { AtomicWakeAll(&OutstandingWork); }
+        }
+
+        bool FrameScheduler::RunForkedTask(Resource& CurrentThread)
+        {
+            if(0>=AtomicLoad(&ForkedTaskCount))
+                { return false; }
+            ForkedTasksLock.Lock();
+            if(ForkedTasks.empty())
+            {
+                ForkedTasksLock.Unlock();
+                return false;
+            }
+            ForkedTask Task = ForkedTasks.back();
+            ForkedTasks.pop_back();
+            AtomicAdd(&ForkedTaskCount,-1);
+            ForkedTasksLock.Unlock();
+
+            Task.Function(Task.Argument, CurrentThread);
+            AtomicAdd(Task.Pending,-1); // The group may be gone once this is seen, so nothing in it is touched after
+            Int32 Remaining = AtomicAdd(&OutstandingWork,-1) - 1;
+            if(0>=Remaining && 0<AtomicAdd(&ParkedThreads,0))
+                { AtomicWakeAll(&OutstandingWork); }
+            return true;
+        }
+
+        void FrameScheduler::JoinForkedTasks(Int32& Pending, Resource& CurrentThread)
+        {
+            while(0<AtomicAdd(&Pending,0))
+            {
+                if(!RunForkedTask(CurrentThread))
+                    { this_thread::yield(); } // The rest are running on other threads
+            }
+        }
+
+        bool FrameScheduler::ServeThreadTeam(Resource& CurrentThread)
+        {
+            if(0>=AtomicLoad(&PendingMonopolies))
+                { return false; }
+            Team.Serve(CurrentThread);
             return true;
         }
 
+        void FrameScheduler::ReleaseDependentsOf(iWorkUnit* Completed, Resource* CompletingThread)
+        {
+            if(0<AtomicAdd(&CompletionWaiterCount,0))
+            {
+                WaitersLock.Lock();
+                for(Whole Waiter = 0; Waiter<CompletionWaiters.size(); )
+                {
+                    if(CompletionWaiters[Waiter].first==Completed)
+                    {
+                        CompletionWaiters[Waiter].second->Wake();
+                        CompletionWaiters[Waiter] = CompletionWaiters.back();
+                        CompletionWaiters.pop_back();
+                        AtomicAdd(&CompletionWaiterCount,-1);
+                    }else{
+                        ++Waiter;
+                    }
+                }
+                WaitersLock.Unlock();
+            }
+            if(ReadinessStale)
+                { return; }
+            Whole Index = DependentGraph.GetIndexOf(Completed);
+            if(DependencyGraph::NotFound==Index || Index>=DependentGraph.GetScheduledCount())
+                { return; }
+
+            if(LookaheadActive)
+            {
+                if(Index<AheadStates.size() && 1==AheadStates[Index]) // Its next frame ran early, nothing in this frame waits on that
+                {
+                    AheadStates[Index] = 2;
+                    AtomicAdd(&AheadRunCount,1);
+                    for(DependencyGraph::ConstIterator Iter=DependentGraph.DependentsBegin(Index); Iter!=DependentGraph.DependentsEnd(Index); ++Iter)
+                    {
+                        if(*Iter<AheadDependencyCounts.size() && -1!=AheadDependencyCounts[*Iter])
+                            { DecrementAhead(*Iter); }
+                    }
+                    return;
+                }
+                if(Index<AheadDependencyCounts.size() && -1!=AheadDependencyCounts[Index])
+                    { DecrementAhead(Index); }
+                std::vector< std::pair<Whole,Whole> >::const_iterator Cross = std::lower_bound(CrossFrameSlots.begin(), CrossFrameSlots.end(), std::pair<Whole,Whole>(Index,0));
+                for(; Cross!=CrossFrameSlots.end() && Cross->first==Index; ++Cross)
+                    { DecrementAhead(Cross->second); }
+            }
+
+            Completed->SetRemainingDependencyCount(DependentGraph.GetScheduledDependencyCount(Index)); // Nothing else will decrement it this frame
+
+            bool ToLocalWork = WorkStealing && CompletingThread && CompletingThread->GetLocalWork().IsActive();
+            bool Released = false;
+            Whole MainCount = DependentGraph.GetMainCount();
+            for(DependencyGraph::ConstIterator Iter=DependentGraph.DependentsBegin(Index); Iter!=DependentGraph.DependentsEnd(Index); ++Iter)
+            {
+                if(0==DependentGraph.GetUnit(*Iter)->DecrementRemainingDependencyCount())
+                {
+                    Released = true;
+                    if(ToLocalWork && *Iter<MainCount)
+                        { CompletingThread->GetLocalWork().Push(Int32(*Iter)); }
+                    else
+                        { PublishReadySlot(*Iter); }
+                }
+            }
+            if(DependentGraph.IsMonopoly(Index))
+                { AtomicAdd(&PendingMonopolies,-1); } // Its team is dismissed after this, so every member sees it
+            Int32 Remaining = AtomicAdd(&OutstandingWork,-1) - 1; // Only after publishing, so a thread seeing this change can find the new work
+            if((Released || 0>=Remaining) && 0<AtomicAdd(&ParkedThreads,0))
+                { AtomicWakeAll(&OutstandingWork); }
+        }
+
+        void FrameScheduler::ResumeSuspendedWorkUnit(void* Suspended, Resource& CurrentThread)
+        {
+            ((ResumableWorkUnit*)Suspended)->operator()(CurrentThread);
+            AtomicAdd(&(CurrentThread.GetFrameScheduler()->OutstandingWork),-1);
+        }
+
+        void FrameScheduler::ResumeWorkUnit(ResumableWorkUnit* Suspended)
+        {
+            // Counted once more until it runs, a completion waking it also lowers the count and parked threads
+            // only return when it changes
+            AtomicAdd(&OutstandingWork,1);
+            ForkTask(ResumeSuspendedWorkUnit, Suspended, ResumesPending);
+        }
+
+        bool FrameScheduler::ResumeOnCompletion(iWorkUnit* Awaited, ResumableWorkUnit* Suspended)
+        {
+            WaitersLock.Lock();
+            CompletionWaiters.push_back(std::pair<iWorkUnit*,ResumableWorkUnit*>(Awaited,Suspended));
+            AtomicAdd(&CompletionWaiterCount,1);
+            WaitersLock.Unlock();
+            if(Complete>Awaited->GetRunningState())
+                { return true; } // It sets its state before releasing its dependents, so this will be seen when it does
+
+            bool Waiting = true; // Unless it is still here, the completion already woke it
+            WaitersLock.Lock();
+            for(std::vector< std::pair<iWorkUnit*,ResumableWorkUnit*> >::iterator Iter = CompletionWaiters.begin(); Iter!=CompletionWaiters.end(); ++Iter)
+            {
+                if(Iter->first==Awaited && Iter->second==Suspended)
+                {
+                    CompletionWaiters.erase(Iter);
+                    AtomicAdd(&CompletionWaiterCount,-1);
+                    Waiting = false;
+                    break;
+                }
+            }
+            WaitersLock.Unlock();
+            return Waiting;
+        }
+
+        void FrameScheduler::ResumeAt(const MaxInt& WakeTime, ResumableWorkUnit* Suspended)
+        {
+            WaitersLock.Lock();
+            TimedWaiters.push_back(std::pair<MaxInt,ResumableWorkUnit*>(WakeTime,Suspended));
+            AtomicAdd(&TimedWaiterCount,1);
+            WaitersLock.Unlock();
+            AtomicAdd(&OutstandingWork,1); // Counted until it is woken, so parked threads return and check the time instead
+            if(0<AtomicAdd(&ParkedThreads,0))
+                { AtomicWakeAll(&OutstandingWork); }
+        }
+
+        MaxInt FrameScheduler::GetNextResumeTime() const
+        {
+            MaxInt Earliest = 0;
+            SpinLock& Lock = const_cast<SpinLock&>(WaitersLock);
+            Lock.Lock();
+            for(std::vector< std::pair<MaxInt,ResumableWorkUnit*> >::const_iterator Iter = TimedWaiters.begin(); Iter!=TimedWaiters.end(); ++Iter)
+            {
+                if(!Earliest || Iter->first<Earliest)
+                    { Earliest = Iter->first; }
+            }
+            Lock.Unlock();
+            return Earliest;
+        }
+
+        void FrameScheduler::ResumeDueWorkUnits()
+        {
+            if(0>=AtomicAdd(&TimedWaiterCount,0))
+                { return; }
+            MaxInt Now = GetTimeStamp();
+            WaitersLock.Lock();
+            for(Whole Waiter = 0; Waiter<TimedWaiters.size(); )
+            {
+                if(TimedWaiters[Waiter].first<=Now)
+                {
+                    TimedWaiters[Waiter].second->Wake();
+                    TimedWaiters[Waiter] = TimedWaiters.back();
+                    TimedWaiters.pop_back();
+                    AtomicAdd(&TimedWaiterCount,-1);
+                    AtomicAdd(&OutstandingWork,-1); // Its resumption is counted now
+                }else{
+                    ++Waiter;
+                }
+            }
+            WaitersLock.Unlock();
+        }
+
+        bool FrameScheduler::DeferAsynchronousWorkUnit(iAsynchronousWorkUnit* Pending)
+        {
+            PendingAsynchronousLock.Lock();
+            if(Running!=Pending->IsWorkDone()) // Completed since it was checked, so it did not find itself here
+            {
+                PendingAsynchronousLock.Unlock();
+                return false;
+            }
+            PendingAsynchronous.push_back(Pending);
+            AsynchronousDeferred = true;
+            Whole Deferred = UpdateDeferredSlots();
+            Int32 Dropped = Int32(Deferred-DeferredCount);
+            DeferredCount = Deferred;
+            Int32 Remaining = AtomicAdd(&OutstandingWork,-Dropped) - Dropped;
+            PendingAsynchronousLock.Unlock();
+            if(0>=Remaining && 0<AtomicAdd(&ParkedThreads,0))
+                { AtomicWakeAll(&OutstandingWork); }
+            return true;
+        }
+
+        bool FrameScheduler::FinishAsynchronousWorkUnit(iAsynchronousWorkUnit* Pending)
+        {
+            PendingAsynchronousLock.Lock();
+            std::vector<iAsynchronousWorkUnit*>::iterator Found = std::find(PendingAsynchronous.begin(), PendingAsynchronous.end(), Pending);
+            if(PendingAsynchronous.end()==Found) // Deferred in a frame that has been reset, it runs again to complete
+            {
+                PendingAsynchronousLock.Unlock();
+                return false;
+            }
+            PendingAsynchronous.erase(Found);
+            Whole Deferred = UpdateDeferredSlots();
+            Int32 Restored = Int32(DeferredCount-Deferred);
+            DeferredCount = Deferred;
+            // Only while the frame is running, once this reaches 0 the threads are leaving and it only rises again next frame
+            Int32 Current = AtomicAdd(&OutstandingWork,0);
+            while(0<Current)
+            {
+                Int32 Seen = AtomicCompareAndSwap32(&OutstandingWork,Current,Current+Restored);
+                if(Seen==Current)
+                    { break; }
+                Current = Seen;
+            }
+            PendingAsynchronousLock.Unlock();
+            return 0<Current;
+        }
+
         void FrameScheduler::UpdateDependentGraph()
         {
-            DependentGraph.clear();
-            UpdateDependentGraph(WorkUnitsMain);
-            UpdateDependentGraph(WorkUnitsAffinity);
+            DependentGraph.Build(WorkUnitsMain, WorkUnitsAffinity, WorkUnitsMonopolies);
+            UpdateDependentCounts();
+            UpdateCriticalPaths();
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -498,12 +1666,255 @@ namespace Mezzanine
         void FrameScheduler::SetFrameLength(const Whole& FrameLength)
             { TargetFrameLength = FrameLength; }
 
+        Whole FrameScheduler::GetMaximumFrameWait() const
+            { return MaximumFrameWait; }
+
+        void FrameScheduler::SetMaximumFrameWait(const Whole& MaximumWait)
+            { MaximumFrameWait = MaximumWait; }
+
+        Whole FrameScheduler::GetFramePacingMargin() const
+            { return PacingMargin; }
+
         Whole FrameScheduler::GetThreadCount()
             { return CurrentThreadCount; }
 
         void FrameScheduler::SetThreadCount(const Whole& NewThreadCount)
             { CurrentThreadCount = NewThreadCount; }
 
+        bool FrameScheduler::GetAdaptiveThreadCount() const
+            { return AdaptiveThreadCount; }
+
+        void FrameScheduler::SetAdaptiveThreadCount(bool Enabled)
+        {
+            AdaptiveThreadCount = Enabled;
+            FramesWithSpareThreads = 0;
+        }
+
+        Whole FrameScheduler::GetMinimumThreadCount() const
+            { return MinimumThreadCount; }
+
+        void FrameScheduler::SetMinimumThreadCount(const Whole& NewMinimum)
+            { MinimumThreadCount = std::max(NewMinimum,Whole(1)); }
+
+        Whole FrameScheduler::GetMaximumThreadCount() const
+            { return MaximumThreadCount; }
+
+        void FrameScheduler::SetMaximumThreadCount(const Whole& NewMaximum)
+            { MaximumThreadCount = NewMaximum; }
+
+        bool FrameScheduler::GetWorkStealing() const
+            { return WorkStealing; }
+
+        void FrameScheduler::SetWorkStealing(bool Enabled)
+            { WorkStealing = Enabled; }
+
+        bool FrameScheduler::GetCriticalPathSorting() const
+            { return CriticalPathSorting; }
+
+        void FrameScheduler::SetCriticalPathSorting(bool Enabled)
+            { CriticalPathSorting = Enabled; }
+
+        bool FrameScheduler::GetFramePipelining() const
+            { return FramePipelining; }
+
+        void FrameScheduler::SetFramePipelining(bool Enabled)
+            { FramePipelining = Enabled; }
+
+        void FrameScheduler::SetWorkUnitPipelined(iWorkUnit* Unit, bool Pipelined)
+        {
+            if(Pipelined==IsWorkUnitPipelined(Unit))
+                { return; }
+            if(Pipelined)
+                { PipelinedUnits.push_back(Unit); }
+            else
+                { PipelinedUnits.erase(std::remove(PipelinedUnits.begin(),PipelinedUnits.end(),Unit), PipelinedUnits.end()); }
+            InvalidateReadiness();
+        }
+
+        bool FrameScheduler::IsWorkUnitPipelined(iWorkUnit* Unit) const
+            { return PipelinedUnits.end()!=std::find(PipelinedUnits.begin(),PipelinedUnits.end(),Unit); }
+
+        void FrameScheduler::AddCrossFrameDependency(iWorkUnit* Dependent, iWorkUnit* Dependency)
+        {
+            CrossFrameDependencies.push_back(std::pair<iWorkUnit*,iWorkUnit*>(Dependent,Dependency));
+            InvalidateReadiness();
+        }
+
+        void FrameScheduler::RemoveCrossFrameDependency(iWorkUnit* Dependent, iWorkUnit* Dependency)
+        {
+            CrossFrameDependencies.erase(
+                        std::remove(CrossFrameDependencies.begin(), CrossFrameDependencies.end(), std::pair<iWorkUnit*,iWorkUnit*>(Dependent,Dependency)),
+                        CrossFrameDependencies.end()
+                    );
+            InvalidateReadiness();
+        }
+
+        Int32 FrameScheduler::GetEarlyStartCount() const
+            { return AtomicAdd(const_cast<Int32*>(&AheadRunCount),0); }
+
+        void FrameScheduler::SetWorkUnitPeriod(iWorkUnit* Unit, const Whole& Period, const Whole& Phase)
+        {
+            std::vector<WorkUnitRate>::iterator Iter = WorkUnitRates.begin();
+            while(Iter!=WorkUnitRates.end() && Iter->Unit!=Unit)
+                { ++Iter; }
+            if(Period<2)
+            {
+                if(Iter!=WorkUnitRates.end())
+                    { WorkUnitRates.erase(Iter); }
+            }else{
+                if(Iter==WorkUnitRates.end())
+                {
+                    WorkUnitRate Rate;
+                    Rate.Unit = Unit;
+                    Iter = WorkUnitRates.insert(Iter,Rate);
+                }
+                Iter->Period = Period;
+                Iter->AutomaticPhase = AutomaticPhase==Phase;
+                Iter->Phase = Iter->AutomaticPhase ? 0 : Phase%Period;
+            }
+            UpdateStaggering();
+            InvalidateReadiness(); // Whether it can be pipelined may have changed
+        }
+
+        Whole FrameScheduler::GetWorkUnitPeriod(iWorkUnit* Unit) const
+        {
+            for(std::vector<WorkUnitRate>::const_iterator Iter = WorkUnitRates.begin(); Iter!=WorkUnitRates.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                    { return Iter->Period; }
+            }
+            return 1;
+        }
+
+        Whole FrameScheduler::GetWorkUnitPhase(iWorkUnit* Unit) const
+        {
+            for(std::vector<WorkUnitRate>::const_iterator Iter = WorkUnitRates.begin(); Iter!=WorkUnitRates.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                    { return Iter->Phase; }
+            }
+            return 0;
+        }
+
+        void FrameScheduler::SetWorkUnitOptional(iWorkUnit* Unit, const Integer& Priority)
+        {
+            for(std::vector<OptionalWorkUnit>::iterator Iter = OptionalUnits.begin(); Iter!=OptionalUnits.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                {
+                    Iter->Priority = Priority;
+                    return;
+                }
+            }
+            OptionalWorkUnit Optional;
+            Optional.Unit = Unit;
+            Optional.Priority = Priority;
+            Optional.FramesShed = 0;
+            OptionalUnits.push_back(Optional);
+            InvalidateReadiness(); // It can no longer be pipelined
+        }
+
+        void FrameScheduler::SetWorkUnitMandatory(iWorkUnit* Unit)
+        {
+            for(std::vector<OptionalWorkUnit>::iterator Iter = OptionalUnits.begin(); Iter!=OptionalUnits.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                {
+                    OptionalUnits.erase(Iter);
+                    InvalidateReadiness();
+                    return;
+                }
+            }
+        }
+
+        bool FrameScheduler::IsWorkUnitOptional(iWorkUnit* Unit) const
+        {
+            for(std::vector<OptionalWorkUnit>::const_iterator Iter = OptionalUnits.begin(); Iter!=OptionalUnits.end(); ++Iter)
+            {
+                if(Iter->Unit==Unit)
+                    { return true; }
+            }
+            return false;
+        }
+
+        Whole FrameScheduler::GetShedCount() const
+            { return ShedCount; }
+
+        ThreadAffinityPolicy FrameScheduler::GetThreadAffinity() const
+            { return AffinityPolicy; }
+
+        void FrameScheduler::SetThreadAffinity(ThreadAffinityPolicy Policy)
+        {
+            AffinityPolicy = Policy;
+            if(NoAffinity==Policy)
+            {
+                AffinityCPUs.clear();
+            }else if(ExplicitAffinity!=Policy){
+                std::vector<LogicalCPU> Topology(GetCPUTopology());
+                std::vector<AffinityRank> Ranks(RankCPUs(Topology));
+                std::sort(Ranks.begin(), Ranks.end(), AffinityOrder(Policy));
+                AffinityCPUs.clear();
+                for(std::vector<AffinityRank>::const_iterator Iter = Ranks.begin(); Iter!=Ranks.end(); ++Iter)
+                    { AffinityCPUs.push_back(Iter->ID); }
+            }
+            UpdateAffinityNodes();
+        }
+
+        void FrameScheduler::SetThreadAffinity(const std::vector<Whole>& CPUs)
+        {
+            AffinityPolicy = CPUs.empty() ? NoAffinity : ExplicitAffinity;
+            AffinityCPUs = CPUs;
+            UpdateAffinityNodes();
+        }
+
+        void FrameScheduler::UpdateAffinityNodes()
+        {
+            AffinityNodes.clear();
+            std::vector<Int32> Distinct;
+            if(!AffinityCPUs.empty())
+            {
+                std::vector<LogicalCPU> Topology(GetCPUTopology());
+                for(std::vector<Whole>::const_iterator CPU = AffinityCPUs.begin(); CPU!=AffinityCPUs.end(); ++CPU)
+                {
+                    Int32 Node = 0; // Unknown processors are assumed to be with the first
+                    for(std::vector<LogicalCPU>::const_iterator Iter = Topology.begin(); Iter!=Topology.end(); ++Iter)
+                    {
+                        if(Iter->ID==*CPU)
+                            { Node = Int32(Iter->Node); }
+                    }
+                    AffinityNodes.push_back(Node);
+                    if(Distinct.end()==std::find(Distinct.begin(),Distinct.end(),Node))
+                        { Distinct.push_back(Node); }
+                }
+            }
+            AffinityNodeCount = Distinct.size();
+            AffinityGeneration++;
+        }
+
+        const std::vector<Whole>& FrameScheduler::GetThreadAffinityCPUs() const
+            { return AffinityCPUs; }
+
+        Whole FrameScheduler::GetThreadAffinityFailureCount() const
+            { return Whole(AtomicLoad(&AffinityFailures)); }
+
+        BarrierAlgorithm FrameScheduler::GetBarrierAlgorithm() const
+            { return FrameBarrierAlgorithm; }
+
+        Whole FrameScheduler::GetIdleSpinCount() const
+            { return IdleSpinCount; }
+
+        void FrameScheduler::SetIdleSpinCount(const Whole& Count)
+            { IdleSpinCount = Count; }
+
+        Whole FrameScheduler::GetIdleYieldCount() const
+            { return IdleYieldCount; }
+
+        void FrameScheduler::SetIdleYieldCount(const Whole& Count)
+            { IdleYieldCount = Count; }
+
+        Int32 FrameScheduler::GetIdleParkCount() const
+            { return AtomicAdd(const_cast<Int32*>(&ParkCount),0); }
+
         MaxInt FrameScheduler::GetCurrentFrameStart() const
             { return CurrentFrameStart; }
 
@@ -524,7 +1935,6 @@ namespace Mezzanine
 
         void FrameScheduler::DoOneFrame()
         {
-            RunAllMonopolies();
             CreateThreads();
             RunMainThreadWork();
             JoinAllThreads();
@@ -534,31 +1944,58 @@ namespace Mezzanine
 
         void FrameScheduler::RunAllMonopolies()
         {
+            if(ReadinessStale)
+            {
+                UpdateReadiness();
+                SkipIdleWorkUnits(FrameCount);
+                SeedReadyWorkUnits();
+            }
             for(IteratorMonoply Iter = WorkUnitsMonopolies.begin(); Iter!=WorkUnitsMonopolies.end(); ++Iter)
-                { (*Iter)->operator()(*(Resources.at(0))); }
+            {
+                if(Starting==(*Iter)->TakeOwnerShip()) // Only those not waiting on anything
+                    { (*Iter)->operator()(*(Resources.at(0))); }
+            }
         }
 
         void FrameScheduler::CreateThreads()
         {
+            UpdateThreadAffinity(0,MainAffinityGeneration); // Might need LogResources to move the main thread's resources
             LogResources.Lock(); //Unlocks in FrameScheduler::RunMainThreadWork() after last resource is swapped
+            IdleTime = 0;
+            if(ReadinessStale)
+            {
+                UpdateReadiness();
+                SkipIdleWorkUnits(FrameCount);
+                SeedReadyWorkUnits();
+            }
+            ForkExpiredTimers();
+            while(Resources.size()<CurrentThreadCount)
+                { Resources.push_back(new DefaultThreadSpecificStorage::Type(this)); }
+            if(WorkStealing)
+                { DistributeReadyWorkUnits(); } // Before any thread starts looking for work
+            PrepareLookahead();
+            Team.SetSize(CurrentThreadCount);
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-                StartFrameSync.SetThreadSyncCount(CurrentThreadCount);
-                EndFrameSync.SetThreadSyncCount(CurrentThreadCount);
                 for(Whole Count = 1; Count<CurrentThreadCount; ++Count)
-                {
-                    if(Count+1>Resources.size())
-                    {
-                        Resources.push_back(new DefaultThreadSpecificStorage::Type(this));
-                        Resources[Count]->SwapAllBufferedResources();
-                        Threads.push_back(new Thread(ThreadWork, Resources[Count]));
-                    }
-                }
-                StartFrameSync.Wait();
+                    { Resources[Count]->SwapAllBufferedResources(); } // Threads are waiting in StartFrameSync, or not yet created
+                EndFrameSync->SetThreadSyncCount(CurrentThreadCount); // Nothing waits on this between frames
+                SyncedThreadCount = CurrentThreadCount;
+                while(Threads.size()+1<CurrentThreadCount)
+                    { Threads.push_back(new Thread(ThreadWork, Resources[Threads.size()+1])); }
+                StartFrameSync->Wait(0); // Releases the threads that have waited since the last frame, and retires any past SyncedThreadCount
+                StartFrameSync->SetThreadSyncCount(CurrentThreadCount); // Nothing waits on this again until this frame ends
+            #elif defined(MEZZ_USETHREADPOOL)
+                for(Whole Count = 1; Count<CurrentThreadCount; ++Count)
+                    { Resources[Count]->SwapAllBufferedResources(); } // Threads in the pool are parked, or not yet created
+                PoolSize = CurrentThreadCount;
+                PoolWorking = CurrentThreadCount-1;
+                AtomicAdd(&PoolFrame,1); // Wakes the pool, and retires any threads past PoolSize
+                AtomicWakeAll(&PoolFrame);
+                while(Threads.size()+1<CurrentThreadCount)
+                    { Threads.push_back(new Thread(ThreadWorkPool, Resources[Threads.size()+1])); }
             #else
                 for(Whole Count = 1; Count<CurrentThreadCount; ++Count)
                 {
-                    if(Count+1>Resources.size())
-                        { Resources.push_back(new DefaultThreadSpecificStorage::Type(this)); }
                     Resources[Count]->SwapAllBufferedResources();
                     Threads.push_back(new Thread(ThreadWork, Resources[Count]));
                 }
@@ -577,7 +2014,22 @@ namespace Mezzanine
         void FrameScheduler::JoinAllThreads()
         {
             #ifdef MEZZ_USEBARRIERSEACHFRAME
-            EndFrameSync.Wait();
+            EndFrameSync->Wait(0);
+            while(Threads.size()+1>Whole(SyncedThreadCount)) // Threads retired when this frame started
+            {
+                Threads.back()->join();
+                delete Threads.back();
+                Threads.pop_back();
+            }
+            #elif defined(MEZZ_USETHREADPOOL)
+            for(Int32 Working = AtomicAdd(&PoolWorking,0); 0<Working; Working = AtomicAdd(&PoolWorking,0))
+                { AtomicWait(&PoolWorking,Working); }
+            while(Threads.size()+1>Whole(PoolSize)) // Threads retired when this frame started
+            {
+                Threads.back()->join();
+                delete Threads.back();
+                Threads.pop_back();
+            }
             #else
             for(std::vector<Thread*>::iterator Iter=Threads.begin(); Iter!=Threads.end(); ++Iter)
             {
@@ -588,47 +2040,189 @@ namespace Mezzanine
             Threads.reserve(CurrentThreadCount);
             #endif
 
+            for(std::vector<Resource*>::iterator Iter=Resources.begin(); Iter!=Resources.end(); ++Iter)
+                { (*Iter)->GetLocalWork().Deactivate(); } // Work released outside a frame goes to the shared pool
+
             if(Sorter)
             {
                 WorkUnitsAffinity = Sorter->WorkUnitsAffinity;
                 WorkUnitsMain = Sorter->WorkUnitsMain;
                 Sorter=0;
+                InvalidateReadiness();
             }
 
+            Team.SetSize(1); // Monopolies run between frames only have the calling thread
             CurrentPauseStart=GetTimeStamp();
+            UpdateThreadCount();
         }
 
         void FrameScheduler::ResetAllWorkUnits()
         {
-            /// @todo could be replace with a parallel for, or a monopoly
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsMain.rbegin(); Iter!=WorkUnitsMain.rend(); ++Iter)
-                { Iter->Unit->PrepareForNextFrame(); }
-            for(std::vector<WorkUnitKey>::reverse_iterator Iter = WorkUnitsAffinity.rbegin(); Iter!=WorkUnitsAffinity.rend(); ++Iter)
-                { Iter->Unit->PrepareForNextFrame(); }
-            #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-            DecacheMain=0;
-            DecacheAffinity=0;
+            std::vector<iWorkUnit*> RanAhead; // The graph is not rebuilt until after this, even if it is stale
+            if(LookaheadActive)
+            {
+                for(Whole Slot=0; Slot<AheadStates.size() && Slot<DependentGraph.GetMainCount(); ++Slot)
+                {
+                    if(2==AheadStates[Slot])
+                        { RanAhead.push_back(DependentGraph.GetUnit(Slot)); }
+                    AheadStates[Slot] = 0;
+                }
+                LookaheadActive = false;
+            }
+
+            PendingAsynchronousLock.Lock(); // Deferred WorkUnits completing now are left to run again next frame
+            bool Deferred = AsynchronousDeferred;
+            PendingAsynchronous.clear();
+            DeferredCount = 0;
+            AsynchronousDeferred = false;
+
+            FrameEpoch++; // Every WorkUnit following the epoch is now NotStarted
+            for(std::vector<iWorkUnit*>::iterator Iter = WorkUnitsWithoutEpoch.begin(); Iter!=WorkUnitsWithoutEpoch.end(); ++Iter)
+                { (*Iter)->PrepareForNextFrame(); }
+            for(std::vector<iWorkUnit*>::iterator Iter = RanAhead.begin(); Iter!=RanAhead.end(); ++Iter)
+                { (*Iter)->MarkComplete(); } // This frame's work was done last frame
+            bool Skipped = SkipIdleWorkUnits(FrameCount+1); // WaitUntilNextFrame counts this frame after this
+            Skipped = ShedOptionalWorkUnits() || Skipped;
+
+            if(ReadinessStale)
+            {
+                UpdateReadiness();
+                SeedReadyWorkUnits();
+            }else if(OutstandingWork || RanAhead.size() || Skipped || Deferred){
+                SeedReadyWorkUnits(); // Some WorkUnits did not finish, already finished or will not run, so their dependents' counts cannot be trusted
+            }else{
+                ReadyMain = InitialReadyMain;
+                ReadyMainCount = Int32(ReadyMain.size());
+                ReadyAffinity = InitialReadyAffinity;
+                PendingMonopolies = InitialReadyMonopolies;
+                OutstandingWork = DependentGraph.GetScheduledCount();
+            }
+            PendingAsynchronousLock.Unlock();
+        }
+
+        void FrameScheduler::RunBackgroundWork(Resource& CurrentThread)
+        {
+            Whole Count = WorkUnitsBackground.size();
+            Whole Start = Whole(AtomicAdd(&BackgroundCursor,1));
+            for(Whole Offset = 0, PassedOver = 0; PassedOver<Count; ++Offset)
+            {
+                Whole Slot = (Start+Offset)%Count;
+                iWorkUnit* Unit = WorkUnitsBackground[Slot];
+                if(BackgroundDeadline<GetTimeStamp()+MaxInt(Unit->GetPerformance()) || 0!=AtomicCompareAndSwap32(&BackgroundBusy[Slot],0,1))
+                {
+                    PassedOver++; // Too long to finish in time, or another thread has it
+                    continue;
+                }
+                Unit->operator()(CurrentThread);
+                AtomicAdd(&BackgroundRunCount,1);
+                AtomicCompareAndSwap32(&BackgroundBusy[Slot],1,0);
+                PassedOver = 0;
+            }
+        }
+
+        void FrameScheduler::RunBackgroundPause(const MaxInt& Deadline)
+        {
+            BackgroundDeadline = Deadline;
+            #ifdef MEZZ_USETHREADPOOL
+            if(Threads.size())
+            {
+                AtomicCompareAndSwap32(&PoolBackground,0,1);
+                AtomicAdd(&PoolWorking,Int32(Threads.size()));
+                AtomicAdd(&PoolFrame,1); // Wakes the pool, which sees PoolBackground and runs background WorkUnits instead of a frame
+                AtomicWakeAll(&PoolFrame);
+            }
             #endif
+            RunBackgroundWork(*Resources[0]);
+            #ifdef MEZZ_USETHREADPOOL
+            for(Int32 Working = AtomicAdd(&PoolWorking,0); 0<Working; Working = AtomicAdd(&PoolWorking,0))
+                { AtomicWait(&PoolWorking,Working); }
+            AtomicCompareAndSwap32(&PoolBackground,1,0);
+            #endif
+        }
+
+        void FrameScheduler::ForkExpiredTimers()
+        {
+            TimersLock.Lock();
+            Timers.Advance(GetTimeStamp(),ExpiredTimers);
+            TimersLock.Unlock();
+            for(std::vector<TimerWheel::ExpiredTimer>::iterator Iter = ExpiredTimers.begin(); Iter!=ExpiredTimers.end(); ++Iter)
+                { ForkTask(Iter->Function, Iter->Argument, TimersPending); }
+            AtomicAdd(&TimerExpiryCount,Int32(ExpiredTimers.size()));
+            ExpiredTimers.clear();
+        }
+
+        void FrameScheduler::RunTimersUntil(const MaxInt& PauseEnd)
+        {
+            for(;;)
+            {
+                TimersLock.Lock();
+                MaxInt Due = Timers.GetNextCheckTime();
+                TimersLock.Unlock();
+                if(Due>=PauseEnd)
+                    { return; }
+                if(WorkUnitsBackground.size() && GetTimeStamp()+MaxInt(PacingMargin)<Due)
+                    { RunBackgroundPause(Due); }
+                this_thread::sleep_until(Due);
+
+                TimersLock.Lock();
+                Timers.Advance(GetTimeStamp(),ExpiredTimers);
+                TimersLock.Unlock();
+                for(Whole Expired = 0; Expired<ExpiredTimers.size(); ++Expired)
+                    { ExpiredTimers[Expired].Function(ExpiredTimers[Expired].Argument, *Resources[0]); }
+                AtomicAdd(&TimerExpiryCount,Int32(ExpiredTimers.size()));
+                ExpiredTimers.clear();
+            }
+        }
+
+        void FrameScheduler::PaceUntil(const MaxInt& WakeTime)
+        {
+            MaxInt SleepEnd = WakeTime - PacingMargin;
+            if(GetTimeStamp()<SleepEnd)
+            {
+                this_thread::sleep_until(SleepEnd);
+                MaxInt Wanted = (GetTimeStamp()-SleepEnd)*3/2; // How late the OS woke this, with some room for it to vary
+                if(Wanted>MaxInt(MEZZ_MAXPACINGMARGIN))
+                    { Wanted = MEZZ_MAXPACINGMARGIN; }
+                if(Wanted>MaxInt(PacingMargin))
+                    { PacingMargin = Whole(Wanted); } // Grow right away so the next frame is not late too
+                else
+                    { PacingMargin -= (PacingMargin-Whole(Wanted))/8; }
+            }
+            while(GetTimeStamp()<WakeTime)
+                { SpinPause(); } // Waking from sleep is too coarse for the last stretch
         }
 
         void FrameScheduler::WaitUntilNextFrame()
         {
             FrameCount++;
-            Whole TargetFrameEnd=0;
+            MaxInt TargetFrameEnd=0;
+            bool WaitCutShort = false;
             if(TargetFrameLength)
             {
-                TargetFrameEnd = TargetFrameLength + CurrentFrameStart;
-                Whole WaitTime = Whole(TargetFrameEnd - GetTimeStamp()) + TimingCostAllowance;
-                if(WaitTime>1000000) /// @todo Replace hard-code timeout with compiler/define/cmake_option
-                    { WaitTime = 0; }
-                Mezzanine::Threading::this_thread::sleep_for( WaitTime );
+                TargetFrameEnd = CurrentFrameStart + TargetFrameLength;
+                MaxInt WakeTime = TargetFrameEnd + TimingCostAllowance;
+                MaxInt Now = GetTimeStamp();
+                if(WakeTime>Now+MaxInt(MaximumFrameWait))
+                {
+                    WakeTime = Now+MaximumFrameWait;
+                    WaitCutShort = true;
+                }
+                if(Timers.GetCount() && Now+MaxInt(PacingMargin)<WakeTime)
+                    { RunTimersUntil(WakeTime-PacingMargin); } // Read without the lock, every WorkUnit that could add one has finished
+                if(WorkUnitsBackground.size() && GetTimeStamp()+MaxInt(PacingMargin)<WakeTime)
+                    { RunBackgroundPause(WakeTime-PacingMargin); }
+                if(GetTimeStamp()<WakeTime)
+                    { PaceUntil(WakeTime); }
             }
             MaxInt Now = GetTimeStamp();
             FrameTimeLog.Insert(Now-CurrentFrameStart); //Track Frame Time for the past while
             PauseTimeLog.Insert(Now-CurrentPauseStart); //Track Pause Time for the past while
             (*LogDestination) << dec << "<FrameTimes Frame=\"" << (FrameCount-1) << "\" PauseTimeLog=\"" << (Now-CurrentPauseStart) << "\" FrameLength=\"" << (Now-CurrentFrameStart) << "\" />" << endl;
             CurrentFrameStart=Now;
-            TimingCostAllowance -= (CurrentFrameStart-TargetFrameEnd);
+            if(WaitCutShort)
+                { TimingCostAllowance = 0; } // Ending early was intended, correcting for it would stretch the frames after
+            else if(TargetFrameLength)
+                { TimingCostAllowance -= Integer(CurrentFrameStart-TargetFrameEnd); }
         }
 
         ////////////////////////////////////////////////////////////////////////////////
@@ -637,6 +2231,9 @@ namespace Mezzanine
         Whole FrameScheduler::GetWorkUnitMonopolyCount() const
             { return this->WorkUnitsMonopolies.size(); }
 
+        Whole FrameScheduler::GetWorkUnitBackgroundCount() const
+            { return this->WorkUnitsBackground.size(); }
+
         Whole FrameScheduler::GetWorkUnitAffinityCount() const
             { return this->WorkUnitsAffinity.size(); }
 
@@ -661,6 +2258,9 @@ namespace Mezzanine
             return NULL;
         }
 
+        ThreadTeam& FrameScheduler::GetThreadTeam()
+            { return Team; }
+
         Logger* FrameScheduler::GetThreadUsableLogger(ThreadId ID)
         {
             Resource* AlmostResults = GetThreadResource(ID);
@@ -670,45 +2270,24 @@ namespace Mezzanine
         }
 
         void FrameScheduler::DependenciesChanged(bool Changed)
-            { this->NeedToLogDeps = Changed; }
+        {
+            this->NeedToLogDeps = Changed;
+            if(Changed)
+                { InvalidateReadiness(); }
+        }
 
         void FrameScheduler::LogDependencies()
         {
             if(this->NeedToLogDeps)
             {
                 this->NeedToLogDeps = false;
-                for(IteratorMain Iter = WorkUnitsMain.begin(); Iter!=WorkUnitsMain.end(); ++Iter)
-                {
-                    Whole MainCount = Iter->Unit->GetImmediateDependencyCount();
-                    for(Whole Counter = 0; Counter<MainCount; Counter++)
-                    {
-                        *(this->LogDestination) << "<WorkUnitDependency "
-                                                   "Unit=\"" << hex << Iter->Unit
-                                                << "\" DependsOn=\"" << Iter->Unit->GetDependency(Counter) << "\" "
-                                                   "/>" << endl;
-                    }
-                }
-
-                for(IteratorAffinity Iter = WorkUnitsAffinity.begin(); Iter!=WorkUnitsAffinity.end(); ++Iter)
-                {
-                    Whole AffinityCount = Iter->Unit->GetImmediateDependencyCount();
-                    for(Whole Counter = 0; Counter<AffinityCount; Counter++)
-                    {
-                        *(this->LogDestination) << "<WorkUnitDependency "
-                                                   "Unit=\"" << hex << Iter->Unit
-                                                << "\" DependsOn=\"" << Iter->Unit->GetDependency(Counter) << "\" "
-                                                   "/>" << endl;
-                    }
-                }
-
-                for(IteratorMonoply Iter = WorkUnitsMonopolies.begin(); Iter!=WorkUnitsMonopolies.end(); ++Iter)
+                for(Whole Index = 0; Index<DependentGraph.GetUnitCount(); ++Index)
                 {
-                    Whole MonopolyCount = (*Iter)->GetImmediateDependencyCount();
-                    for(Whole Counter = 0; Counter<MonopolyCount; Counter++)
+                    for(DependencyGraph::ConstIterator Iter=DependentGraph.DependenciesBegin(Index); Iter!=DependentGraph.DependenciesEnd(Index); ++Iter)
                     {
                         *(this->LogDestination) << "<WorkUnitDependency "
-                                                   "Unit=\"" << hex << (*Iter)
-                                                << "\" DependsOn=\"" << (*Iter)->GetDependency(Counter) << "\" "
+                                                   "Unit=\"" << hex << DependentGraph.GetUnit(Index)
+                                                << "\" DependsOn=\"" << DependentGraph.GetUnit(*Iter) << "\" "
                                                    "/>" << endl;
                     }
                 }
@@ -44,8 +44,13 @@
 #include "datatypes.h"
 
 #if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
+#include "dependencygraph.h"
 #include "doublebufferedresource.h"
+#include "forkjoingroup.h"
 #include "thread.h"
+#include "threadingenumerations.h"
+#include "threadteam.h"
+#include "timerwheel.h"
 #include "workunitkey.h"
 #include "spinlock.h"
 #include "systemcalls.h"
@@ -54,6 +59,7 @@
 
 #ifdef MEZZ_USEBARRIERSEACHFRAME
     #include "barrier.h"
+    #include "treebarrier.h"
 #endif
 
 /// @file
@@ -63,10 +69,12 @@ namespace Mezzanine
 {
     namespace Threading
     {
+        class iAsynchronousWorkUnit;
         class MonopolyWorkUnit;
         class iWorkUnit;
         class LogAggregator;
         class FrameScheduler;
+        class ResumableWorkUnit;
         class WorkSorter;
 
         /// @brief This is central object in this algorithm, it is responsible for spawning threads and managing the order that work units are executed.
@@ -76,6 +84,14 @@ namespace Mezzanine
         {
             friend class LogAggregator;
             friend class WorkSorter;
+#ifndef SWIG
+            /// @cond false
+    #ifdef MEZZ_USETHREADPOOL
+            friend void ThreadWorkPool(void* ThreadStorage);
+    #endif
+            friend void ThreadWork(void* ThreadStorage);
+            /// @endcond
+#endif
 
             protected:
                 ////////////////////////////////////////////////////////////////////////////////
@@ -105,18 +121,24 @@ namespace Mezzanine
                 /// @brief A const iterator suitable for iterating over the main pool of work units.
                 typedef std::vector<WorkUnitKey>::const_iterator ConstIteratorAffinity;
 
-                /// @brief A structure designed to minimalistically represent Dependency and Reverse Dependency Graphs in work units.
-                typedef std::map<
-                                iWorkUnit*,
-                                std::set<iWorkUnit*>
-                            > DependentGraphType;
-
                 /// @brief This structure allows reverse lookup of dependencies.
-                /// @details This is is a key part of the workunit sorting algorithm. This is calculated during calls to generate
-                /// @ref Mezzanine::Threading::WorkUnitKey "WorkUnitKey"s,
-                /// @warning
-                /// @todo write this warning, it is important, but not easy to lay out.
-                DependentGraphType DependentGraph;
+                /// @details This is is a key part of the workunit sorting algorithm and is what decides when WorkUnits are ready
+                /// to run. It is rebuilt by @ref UpdateDependentGraph and whenever WorkUnits are sorted, so the indexes of main
+                /// and affinity WorkUnits always match their order in @ref WorkUnitsMain and @ref WorkUnitsAffinity.
+                /// @warning Changing the dependencies of a WorkUnit after this is built without calling @ref DependenciesChanged
+                /// leaves this describing the old dependencies.
+                DependencyGraph DependentGraph;
+
+                /// @brief The transitive dependent count of each WorkUnit, indexed the same as the @ref DependentGraph.
+                std::vector<Whole> DependentCounts;
+
+                /// @brief The transitive dependency count of each WorkUnit, indexed the same as the @ref DependentGraph.
+                std::vector<Whole> DependencyCounts;
+
+                /// @brief The critical path length of each WorkUnit, indexed the same as the @ref DependentGraph.
+                /// @details This is refreshed with the @ref DependentGraph and each time the WorkUnitKeys are refreshed, because
+                /// the measured execution times feed into it.
+                std::vector<Whole> CriticalPaths;
 
             public:
                 /// @brief The kind of Resource the frame scheduler will use
@@ -161,30 +183,302 @@ namespace Mezzanine
                 #ifdef MEZZ_USEBARRIERSEACHFRAME
             public:
                 /// @brief Used to synchronize the starting an stopping of all threads before the frame starts.
-                Barrier StartFrameSync;
+                /// @details Threads wait on this after each frame, and the main thread releases them by waiting on it when the next
+                /// frame starts. Threads created for a frame start working without waiting on it.
+                Barrier* StartFrameSync;
 
                 /// @brief Used to synchronize the starting and stopping of all threads after work is done before the frame ends.
-                Barrier EndFrameSync;
+                Barrier* EndFrameSync;
 
                 /// @brief When using barriers instead of thread creation for synchronization this is what tells the threads to end.
                 Int32 LastFrame;
+
+                /// @brief How many threads, including the main thread, work this frame. Threads past this exit after StartFrameSync.
+                Int32 SyncedThreadCount;
             protected:
                 #endif
 
+                #ifdef MEZZ_USETHREADPOOL
+                /// @brief Changed to start each frame, threads in the pool are parked waiting for this to change between frames.
+                Int32 PoolFrame;
+
+                /// @brief How many threads in the pool have not finished the work of this frame.
+                Int32 PoolWorking;
+
+                /// @brief How many threads, including the main thread, work this frame. Threads in the pool past this exit when woken.
+                Int32 PoolSize;
+
+                /// @brief Not 0 while the pool is woken to run background WorkUnits in the pause between frames instead of a frame.
+                Int32 PoolBackground;
+                #endif
+
                 /// @brief Protects DoubleBufferedResources during creation from being accessed by the LogAggregator.
                 SpinLock LogResources;
 
-                #ifdef MEZZ_USEATOMICSTODECACHECOMPLETEWORK
-                /// @brief Indicates the beginning of work that must be searched when starting a fresh search for work in WorkUnitsMain.
-                Int32 DecacheMain;
+                /// @brief The slots of main WorkUnits whose dependencies are all complete and have not been handed out yet, kept as a max-heap.
+                std::vector<Whole> ReadyMain;
 
-                /// @brief Indicates the beginning of work that must be searched when starting a fresh search for work in WorkUnitsAffinity.
-                Int32 DecacheAffinity;
-                #endif
+                /// @brief The slots of affinity WorkUnits whose dependencies are all complete and have not been handed out yet, kept as a max-heap.
+                std::vector<Whole> ReadyAffinity;
+
+                /// @brief Protects ReadyMain while WorkUnits are published and acquired.
+                SpinLock ReadyMainLock;
+
+                /// @brief Protects ReadyAffinity while WorkUnits are published and acquired.
+                SpinLock ReadyAffinityLock;
+
+                /// @brief The size of ReadyMain, changed with ReadyMainLock held and read without it so threads with work of
+                /// their own can skip the lock when it is empty.
+                Int32 ReadyMainCount;
+
+                /// @brief Set when WorkUnits are added, removed or re-ordered so the @ref DependentGraph is rebuilt and remaining dependencies counted before the next use.
+                bool ReadinessStale;
+
+                /// @brief The main WorkUnits that are ready when a frame starts, kept as a max-heap and copied into ReadyMain on reset.
+                std::vector<Whole> InitialReadyMain;
+
+                /// @brief The affinity WorkUnits that are ready when a frame starts, kept as a max-heap and copied into ReadyAffinity on reset.
+                std::vector<Whole> InitialReadyAffinity;
+
+                /// @brief How many of InitialReadyAffinity are Monopolies.
+                Int32 InitialReadyMonopolies;
+
+                /// @brief How many Monopolies are ready or running, no other WorkUnit starts while this is more than 0.
+                Int32 PendingMonopolies;
+
+                /// @brief The threads of this scheduler lent to the running Monopoly.
+                ThreadTeam Team;
+
+                /// @brief How many main and affinity WorkUnits and Monopolies have not yet completed and released their dependents this frame.
+                /// @details Tasks forked by running WorkUnits are counted here too until they complete. This is atomically lowered as each WorkUnit completes, so checking whether a frame is done is a single
+                /// read. If this is 0 at the end of a frame, every remaining dependency count was restored as its WorkUnit
+                /// completed and nothing needs to be counted again.
+                Int32 OutstandingWork;
+
+                /// @brief How many times a thread with nothing to do re-reads OutstandingWork before it starts yielding.
+                Whole IdleSpinCount;
+
+                /// @brief How many times a thread with nothing to do yields after spinning before it parks.
+                Whole IdleYieldCount;
+
+                /// @brief How many threads are currently parked waiting on OutstandingWork, so completing WorkUnits only wake when needed.
+                mutable Int32 ParkedThreads;
+
+                /// @brief How many times any thread has parked since this was constructed.
+                mutable Int32 ParkCount;
+
+                /// @brief Changed once between every frame, WorkUnits following this consider themselves reset when it changes.
+                Whole FrameEpoch;
+
+                /// @brief WorkUnits that do not follow the FrameEpoch and must have PrepareForNextFrame called on them each frame.
+                std::vector<iWorkUnit*> WorkUnitsWithoutEpoch;
+
+                /// @brief When true each thread keeps its own deque of ready work and steals from others when it runs out.
+                bool WorkStealing;
+
+                /// @brief When true WorkUnitKeys include the critical path length of each WorkUnit and are sorted primarily by it.
+                bool CriticalPathSorting;
+
+                /// @brief When true threads that run out of work start WorkUnits of the next frame early, see @ref SetFramePipelining.
+                bool FramePipelining;
+
+                /// @brief The WorkUnits allowed to start their next frame early when pipelining.
+                std::vector<iWorkUnit*> PipelinedUnits;
+
+                /// @brief Each entry is a dependent and a dependency, the dependent's next frame cannot start before the dependency's current frame completes.
+                std::vector< std::pair<iWorkUnit*,iWorkUnit*> > CrossFrameDependencies;
+
+                /// @brief For each main WorkUnit, how many dependencies and cross-frame dependencies its next frame waits on, or -1 if it cannot start early.
+                std::vector<Int32> AheadDependencyCounts;
+
+                /// @brief The slots of the dependency and the dependent of each cross-frame dependency whose dependent can start early.
+                std::vector< std::pair<Whole,Whole> > CrossFrameSlots;
+
+                /// @brief For each main WorkUnit, how many things its next frame still waits on, including its current frame.
+                std::vector<Int32> AheadRemaining;
+
+                /// @brief For each main WorkUnit, 0 if its next frame has not started, 1 while it is running early and 2 once that is complete.
+                std::vector<Int32> AheadStates;
+
+                /// @brief The slots of main WorkUnits whose next frame can start now.
+                std::vector<Whole> ReadyAhead;
+
+                /// @brief Protects ReadyAhead while WorkUnits are published and acquired.
+                SpinLock ReadyAheadLock;
+
+                /// @brief The size of ReadyAhead, changed with ReadyAheadLock held and read without it so idle threads can
+                /// skip the lock when nothing can start early.
+                Int32 ReadyAheadCount;
+
+                /// @brief True during a frame if pipelining is enabled and some WorkUnit could start its next frame early.
+                bool LookaheadActive;
+
+                /// @brief How many times a WorkUnit has started its next frame early since this was constructed.
+                Int32 AheadRunCount;
+
+                /// @brief A WorkUnit that only runs on some frames, see @ref SetWorkUnitPeriod.
+                struct WorkUnitRate
+                {
+                    /// @brief The WorkUnit.
+                    iWorkUnit* Unit;
+                    /// @brief It runs once every this many frames.
+                    Whole Period;
+                    /// @brief It runs on frames whose count divided by Period leaves this remainder.
+                    Whole Phase;
+                    /// @brief True if this scheduler chooses Phase to spread the load.
+                    bool AutomaticPhase;
+                };
+
+                /// @brief Every WorkUnit that does not run every frame.
+                std::vector<WorkUnitRate> WorkUnitRates;
+
+                /// @brief A WorkUnit that can be left out of a frame that would otherwise miss its deadline, see @ref SetWorkUnitOptional.
+                struct OptionalWorkUnit
+                {
+                    /// @brief The WorkUnit.
+                    iWorkUnit* Unit;
+                    /// @brief WorkUnits with lower priorities are shed first.
+                    Integer Priority;
+                    /// @brief How many frames in a row it has been shed, this is added to its priority so it is not always the one left out.
+                    Whole FramesShed;
+                };
+
+                /// @brief Every WorkUnit that is not required to run each frame.
+                std::vector<OptionalWorkUnit> OptionalUnits;
+
+                /// @brief How many times an optional WorkUnit has been left out of a frame since this was constructed.
+                Whole ShedCount;
+
+                /// @brief WorkUnits that only run in the pause between frames, see @ref AddWorkUnitBackground.
+                std::vector<iWorkUnit*> WorkUnitsBackground;
+
+                /// @brief One flag for each background WorkUnit, not 0 while a thread is running it.
+                std::vector<Int32> BackgroundBusy;
+
+                /// @brief The timestamp background WorkUnits must be finished by in the current pause.
+                MaxInt BackgroundDeadline;
+
+                /// @brief Where the next thread starts looking for a background WorkUnit, so threads spread out over them.
+                Int32 BackgroundCursor;
+
+                /// @brief How many times a background WorkUnit has run since this was constructed.
+                Int32 BackgroundRunCount;
+
+                /// @brief A task forked by a running WorkUnit and the count of the group that will join it.
+                struct ForkedTask
+                {
+                    /// @brief The work to do.
+                    ForkedFunction Function;
+                    /// @brief Passed to Function.
+                    void* Argument;
+                    /// @brief Lowered once Function returns.
+                    Int32* Pending;
+                };
+
+                /// @brief Tasks forked by running WorkUnits that no thread has started yet, the newest last.
+                std::vector<ForkedTask> ForkedTasks;
+
+                /// @brief Protects ForkedTasks while tasks are forked and started.
+                SpinLock ForkedTasksLock;
+
+                /// @brief The size of ForkedTasks, changed with ForkedTasksLock held and read without it so threads looking
+                /// for work can skip the lock when no task is waiting.
+                Int32 ForkedTaskCount;
+
+                /// @brief How many suspended @ref ResumableWorkUnit "ResumableWorkUnit"s have been forked to resume and not yet run.
+                Int32 ResumesPending;
+
+                /// @brief Suspended WorkUnits each paired with the WorkUnit whose completion resumes it.
+                std::vector< std::pair<iWorkUnit*,ResumableWorkUnit*> > CompletionWaiters;
+
+                /// @brief Suspended WorkUnits each paired with the timestamp that resumes it.
+                std::vector< std::pair<MaxInt,ResumableWorkUnit*> > TimedWaiters;
+
+                /// @brief Protects CompletionWaiters and TimedWaiters.
+                SpinLock WaitersLock;
+
+                /// @brief The size of CompletionWaiters, read without the lock so completing WorkUnits can skip it when empty.
+                Int32 CompletionWaiterCount;
+
+                /// @brief The size of TimedWaiters, while not 0 idle threads park no later than the earliest is due.
+                Int32 TimedWaiterCount;
+
+                /// @brief Asynchronous WorkUnits that ran this frame while their asynchronous work was still running.
+                std::vector<iAsynchronousWorkUnit*> PendingAsynchronous;
+
+                /// @brief One entry per scheduled slot, 1 if it is in PendingAsynchronous or depends on one that is.
+                /// @details These are not counted in OutstandingWork, so the frame can end without them.
+                std::vector<char> DeferredSlots;
+
+                /// @brief How many entries of DeferredSlots are 1.
+                Whole DeferredCount;
+
+                /// @brief Set once any WorkUnit is deferred this frame, so the next frame's dependency counts are seeded again.
+                bool AsynchronousDeferred;
+
+                /// @brief Protects PendingAsynchronous and DeferredSlots, held while a frame is reset so none finish as it does.
+                SpinLock PendingAsynchronousLock;
+
+                /// @brief Timers added with @ref AddTimer.
+                TimerWheel Timers;
+
+                /// @brief Protects Timers, which WorkUnits may add to and cancel from on any thread.
+                SpinLock TimersLock;
+
+                /// @brief Timers that expired and have not been run or forked yet, only the main thread uses this.
+                std::vector<TimerWheel::ExpiredTimer> ExpiredTimers;
+
+                /// @brief How many expired timers forked into the current frame have not completed.
+                Int32 TimersPending;
+
+                /// @brief How many times a timer has expired since this was constructed.
+                Int32 TimerExpiryCount;
+
+                /// @brief Which kind of barrier synchronizes threads between frames when @ref MEZZ_USEBARRIERSEACHFRAME is set.
+                BarrierAlgorithm FrameBarrierAlgorithm;
 
                 /// @brief How many threads will this try to execute with in the next frame.
                 Whole CurrentThreadCount;
 
+                /// @brief When true the thread count is adjusted between frames, see @ref SetAdaptiveThreadCount.
+                bool AdaptiveThreadCount;
+
+                /// @brief The fewest threads the adaptive thread count will use.
+                Whole MinimumThreadCount;
+
+                /// @brief The most threads the adaptive thread count will use.
+                Whole MaximumThreadCount;
+
+                /// @brief How many frames in a row could have been done with one less thread.
+                Whole FramesWithSpareThreads;
+
+                /// @brief The total microseconds every thread spent waiting for work this frame, only counted with an adaptive thread count.
+                mutable Int32 IdleTime;
+
+                /// @brief How threads are assigned to logical processors, see @ref SetThreadAffinity.
+                ThreadAffinityPolicy AffinityPolicy;
+
+                /// @brief The logical processor each thread is pinned to, by thread index modulo its size. Empty when threads are not pinned.
+                std::vector<Whole> AffinityCPUs;
+
+                /// @brief The NUMA node of each entry in AffinityCPUs.
+                std::vector<Int32> AffinityNodes;
+
+                /// @brief How many different NUMA nodes are in AffinityNodes.
+                Whole AffinityNodeCount;
+
+                /// @brief The NUMA node each main WorkUnit last ran on when work stealing, by readiness slot, -1 if not known.
+                std::vector<Int32> UnitNodes;
+
+                /// @brief Changed each time the affinity is set, threads re-pin themselves when this differs from the last one they used.
+                Int32 AffinityGeneration;
+
+                /// @brief The AffinityGeneration the main thread last pinned itself with.
+                Int32 MainAffinityGeneration;
+
+                /// @brief How many times a thread failed to pin itself or clear its affinity, see @ref GetThreadAffinityFailureCount.
+                Int32 AffinityFailures;
+
                 /// @brief Used to store a count of frames from the begining of game execution.
                 /// @warning At 60 Frames per second this loops in 2 years, 3 months, 6 days and around 18 hours, this may not be suitable for high uptime servers. Using a MaxInt fixes this.
                 Whole FrameCount;
@@ -195,6 +489,14 @@ namespace Mezzanine
                 /// @brief To prevent frame time drift this many microseconds is subtracted from the wait period to allow time for calculations.
                 Integer TimingCostAllowance;
 
+                /// @brief The longest a single pause between frames may be, in microseconds.
+                Whole MaximumFrameWait;
+
+                /// @brief How long before the end of a pause to stop sleeping and spin, in microseconds.
+                /// @details This grows to about half again how late the operating system last woke this thread and slowly
+                /// shrinks back when it wakes sooner, up to @ref MEZZ_MAXPACINGMARGIN.
+                Whole PacingMargin;
+
                 /// @brief For some task it is important to know the ID of the main thread.
                 ThreadId MainThreadID;
 
@@ -216,14 +518,135 @@ namespace Mezzanine
                 /// @brief Simply iterates over and deletes everything in Threads.
                 void DeleteThreads();
 
-                /// @brief Adds the dependencies of the @ref Mezzanine::Threading::iWorkUnit "iWorkUnit"s in the passed containter to the the internal reverse dependency graph.
-                /// @param Units The container to examine for dependency relationships.
-                void UpdateDependentGraph(const std::vector<WorkUnitKey> &Units);
+                /// @brief Adjust the thread count for the next frame from how this frame went, if the thread count is adaptive.
+                /// @details This adds a thread as soon as a frame uses more than 90% of the target frame length while its threads
+                /// were busy for more than all but one thread's share of the frame. If they waited on each other more than that, another
+                /// thread would only wait too. It removes a thread when the time spent doing work, spread over one less
+                /// thread, would have used less than half of the target frame length for @ref MEZZ_FRAMESTOTRACK frames in a row. The gap
+                /// between these and the wait before removing threads keep the thread count from changing back and forth.
+                virtual void UpdateThreadCount();
+
+                /// @brief Pin the calling thread to the logical processor for its index if the affinity changed since it last did.
+                /// @param Index The index of the calling thread, 0 for the main thread, the same as its index in Resources.
+                /// @param PinnedGeneration The AffinityGeneration the calling thread last pinned itself with, this is only updated
+                /// if the operating system accepted the change, otherwise the thread tries again next frame.
+                /// @details If the thread's resources are not on the NUMA node of its logical processor and its deque is not
+                /// active this frame, the thread also moves its resources there with @ref ThreadSpecificStorage::PlaceOnNode.
+                /// @warning Only call this at the start of a frame, when the affinity cannot be changing.
+                void UpdateThreadAffinity(const Whole& Index, Int32& PinnedGeneration);
+
+                /// @brief Join the @ref ThreadTeam of a Monopoly if one is ready or running.
+                /// @param CurrentThread The resources of the calling worker thread.
+                /// @details Worker threads call this when they have nothing else to do. Returns once the Monopoly is done.
+                /// @return True if the thread served in a team, false if no Monopoly needed it.
+                bool ServeThreadTeam(Resource& CurrentThread);
+
+                /// @brief Find the NUMA node of each logical processor threads are pinned to, and have threads re-pin themselves.
+                void UpdateAffinityNodes();
+
+                /// @brief Work out which main WorkUnits can start their next frame early and what each waits on, from the @ref DependentGraph.
+                /// @details A WorkUnit can start early if it was passed to @ref SetWorkUnitPipelined and each of its dependencies is a
+                /// main WorkUnit that can also start early. Monopolies and affinity WorkUnits never start early.
+                void UpdateLookahead();
+
+                /// @brief Count what the next frame of each WorkUnit waits on and publish any that can already start.
+                /// @details WorkUnits that completed this frame's work during the previous frame already count as complete.
+                void PrepareLookahead();
+
+                /// @brief Lower the count of things the next frame of a WorkUnit waits on, and publish it if that was the last.
+                /// @param Slot The main slot of the WorkUnit.
+                void DecrementAhead(const Whole& Slot);
+
+                /// @brief Drop a WorkUnit's pipelining, cross-frame dependencies, period and optionality.
+                /// @param Unit The WorkUnit being removed from this scheduler.
+                void ForgetWorkUnit(iWorkUnit* Unit);
+
+                /// @brief Choose the phase of every WorkUnit with an automatic phase.
+                /// @details WorkUnits with the same period are considered from the slowest to the fastest, according to their
+                /// performance logs, and each is given the phase with the least work so far. This keeps frames about as busy as
+                /// each other instead of every WorkUnit with a period running on the same frame.
+                void UpdateStaggering();
+
+                /// @brief Mark every WorkUnit that does not run in a frame as Complete.
+                /// @param Frame The count of the frame about to be seeded.
+                /// @details Skipped WorkUnits are then never made ready or waited on, and their dependents start without them.
+                /// Call this after WorkUnits are reset and before they are seeded.
+                /// @return True if any WorkUnit was skipped.
+                bool SkipIdleWorkUnits(const Whole& Frame);
+
+                /// @brief Mark optional WorkUnits Complete until the next frame's predicted work fits in its budget.
+                /// @details The budget is the target frame length less however late this frame is running and any debt in
+                /// @ref TimingCostAllowance. The predicted work is the sum of the performance logs of every WorkUnit still to
+                /// run, divided by the thread count. Optional WorkUnits are shed from the lowest priority up, and each frame one
+                /// is shed its priority rises by one until it runs again. Nothing is shed without a target frame length.
+                /// @return True if any WorkUnit was shed.
+                bool ShedOptionalWorkUnits();
+
+                /// @brief Run background WorkUnits on one thread until none left would finish by @ref BackgroundDeadline.
+                /// @param CurrentThread The resources of the thread doing the work.
+                void RunBackgroundWork(Resource& CurrentThread);
+
+                /// @brief Run background WorkUnits in the pause between frames until they would not finish by a deadline.
+                /// @details The main thread runs them, and with the thread pool the parked threads are woken to help. This
+                /// returns after every thread has stopped.
+                /// @param Deadline A timestamp from @ref GetTimeStamp by which every background WorkUnit must be done.
+                void RunBackgroundPause(const MaxInt& Deadline);
+
+                /// @brief Fork every timer that expired since the last check so the threads run it in this frame.
+                /// @details This is called as a frame starts, after the count of outstanding work is set.
+                void ForkExpiredTimers();
+
+                /// @brief Sleep until each timer expiring before a deadline, running them on the main thread as they expire.
+                /// @details Background WorkUnits run while waiting for each, if any would finish in time.
+                /// @param PauseEnd A timestamp from @ref GetTimeStamp, timers expiring after this are left for the next frame.
+                void RunTimersUntil(const MaxInt& PauseEnd);
+
+                /// @brief Sleep until shortly before a time, then spin until it, and recalibrate the margin between the two.
+                /// @param WakeTime A timestamp from @ref GetTimeStamp to return at.
+                void PaceUntil(const MaxInt& WakeTime);
+
+                /// @brief Count every dependent and every dependency of each WorkUnit in one pass each way over the @ref DependentGraph.
+                void UpdateDependentCounts();
+
+                /// @brief Find the critical path length of each WorkUnit in one pass over the @ref DependentGraph.
+                void UpdateCriticalPaths();
 
                 /// @brief Iterate over the passed container of @ref WorkUnitKey "WorkUnitKey"s and refresh them with the correct data from their respective @ref Mezzanine::Threading::iWorkUnit "iWorkUnit"s
                 /// @param Units The container to examine for @ref WorkUnitKey "WorkUnitKey" metadata.
                 void UpdateWorkUnitKeys(std::vector<WorkUnitKey> &Units);
 
+                /// @brief Mark the readiness tables as out of date and forget any WorkUnits waiting to be handed out.
+                void InvalidateReadiness();
+
+                /// @brief Rebuild the @ref DependentGraph from the current WorkUnit containers and mark it as usable for readiness.
+                /// @details This also finds the WorkUnits that are ready at the start of every frame.
+                void UpdateReadiness();
+
+                /// @brief Set the remaining dependency count on each WorkUnit and publish every WorkUnit that is ready to start.
+                /// @details Only dependencies on main or affinity WorkUnits that are not already complete are counted. Monopolies
+                /// always finish before other work starts, so they are never waited on. WorkUnits that are already complete are
+                /// given the count they will need next frame.
+                void SeedReadyWorkUnits();
+
+                /// @brief Mark in DeferredSlots each WorkUnit in PendingAsynchronous and everything depending on them.
+                /// @details Call this with PendingAsynchronousLock held.
+                /// @return How many slots are marked.
+                Whole UpdateDeferredSlots();
+
+                /// @brief Make the WorkUnit at an index in the @ref DependentGraph available to @ref GetNextWorkUnit or @ref GetNextWorkUnitAffinity.
+                /// @param Slot The index in the @ref DependentGraph of a WorkUnit that has no incomplete dependencies.
+                void PublishReadySlot(const Whole& Slot);
+
+                /// @brief Move all the ready main WorkUnits into the deques of the threads that will run this frame.
+                /// @details The highest priority work is dealt out first and round robin, so each thread starts on the most
+                /// important work it was given and the important work is spread across threads.
+                void DistributeReadyWorkUnits();
+
+                /// @brief Try to take a ready main WorkUnit from another thread's deque.
+                /// @param Thief The resource of the thread that is out of work.
+                /// @return A pointer to a WorkUnit that has not started or 0 if nothing could be stolen.
+                iWorkUnit* StealWorkUnit(Resource& Thief);
+
             public:
 
                 ////////////////////////////////////////////////////////////////////////////////
@@ -232,19 +655,25 @@ namespace Mezzanine
                 /// @brief Create a Framescheduler that owns a filestream for logging.
                 /// @param _LogDestination An fstream that will be closed and deleted when this framescheduler is destroyed. Defaults to a new Filestream Logging to local file.
                 /// @param StartingThreadCount How many threads. Defaults to the value returned by @ref Mezzanine::GetCPUCount "GetCPUCount()".
+                /// @param FrameBarriers Which kind of barrier to synchronize threads between frames with, if Mezz_MinimizeThreadsEachFrame
+                /// was enabled. A @ref CombiningTreeBarrier contends less with very many threads. Defaults to a @ref CentralBarrier.
                 /// @warning This must be constructed from the Main(only) thread for any features with thread affinity to work correctly.
                 FrameScheduler(
                         std::fstream* _LogDestination = 0,
-                        Whole StartingThreadCount = GetCPUCount()
+                        Whole StartingThreadCount = GetCPUCount(),
+                        BarrierAlgorithm FrameBarriers = CentralBarrier
                     );
 
                 /// @brief Create a Framescheduler, that logs to an unowned stream.
                 /// @param _LogDestination Any stream, other than an fstream, and it will be closed (not deleted) when this frame scheduler is destroyed.
                 /// @param StartingThreadCount How many threads. Defaults to the value returned by @ref Mezzanine::GetCPUCount "GetCPUCount()".
+                /// @param FrameBarriers Which kind of barrier to synchronize threads between frames with, if Mezz_MinimizeThreadsEachFrame
+                /// was enabled. A @ref CombiningTreeBarrier contends less with very many threads. Defaults to a @ref CentralBarrier.
                 /// @warning This must be constructed from the Main(only) thread for any features with thread affinity to work correctly.
                 FrameScheduler(
                         std::ostream* _LogDestination,
-                        Whole StartingThreadCount = GetCPUCount()
+                        Whole StartingThreadCount = GetCPUCount(),
+                        BarrierAlgorithm FrameBarriers = CentralBarrier
                     );
 
                 /// @brief Destructor
@@ -264,11 +693,24 @@ namespace Mezzanine
                 /// @param WorkUnitName A name to uniquely identify this work unit in the logs
                 virtual void AddWorkUnitAffinity(iWorkUnit* MoreWork, const String& WorkUnitName);
 
-                /// @brief Add a @ref MonopolyWorkUnit for execution at the beginning of the frame.
+                /// @brief Add a @ref MonopolyWorkUnit for execution with every thread this frame uses.
+                /// @details A Monopoly without dependencies runs at the beginning of the frame, one with dependencies runs as soon
+                /// as they are complete. Other WorkUnits can depend on Monopolies.
                 /// @param MoreWork A pointer to the @ref MonopolyWorkUnit to add.
                 /// @param WorkUnitName A name to uniquely identify this work unit in the logs
                 virtual void AddWorkUnitMonopoly(MonopolyWorkUnit* MoreWork, const String& WorkUnitName);
 
+                /// @brief Add a WorkUnit that only runs in the pause between frames.
+                /// @details Whenever a frame finishes before its target length, background WorkUnits run during what would
+                /// otherwise be sleep. The main thread runs them, and with the thread pool so do the parked threads. A thread
+                /// only starts one if its performance log says it will finish before the next frame must start, and each
+                /// can run many times in one pause, so each run should do a small slice of a larger job and keep its own
+                /// progress. Background WorkUnits are not part of the frame, nothing should depend on them and they should not
+                /// depend on anything. Nothing runs in the background without a target frame length.
+                /// @param MoreWork A pointer the the WorkUnit, that the FrameScheduler will take ownership of.
+                /// @param WorkUnitName A name to uniquely identify this work unit in the logs
+                virtual void AddWorkUnitBackground(iWorkUnit* MoreWork, const String& WorkUnitName);
+
                 /// @brief Sort the the main pool of WorkUnits to allow them to be used more efficiently in the next frame executed.
                 /// @param UpdateDependentGraph_ Should the internal cache of reverse dependents be updated.
                 /// @details See @ref Mezzanine::Threading::FrameScheduler::DependentGraph "DependentGraph"
@@ -304,32 +746,212 @@ namespace Mezzanine
                 /// @param LessWork A pointer to the MonopolyWorkUnit the calling coding will reclaim ownership of and will no longer be scheduled, and have its dependencies removed.
                 virtual void RemoveWorkUnitMonopoly(MonopolyWorkUnit* LessWork);
 
+                /// @brief Remove a WorkUnit from those run in the pause between frames.
+                /// @param LessWork A pointer to the workunit the calling coding will reclaim ownership of and will no longer be run.
+                virtual void RemoveWorkUnitBackground(iWorkUnit* LessWork);
+
+                /// @brief How many times has a background WorkUnit run?
+                /// @return The count since this was constructed.
+                virtual Int32 GetBackgroundRunCount() const;
+
+                /// @brief Run a function after a delay, and optionally again after every period until cancelled.
+                /// @param Function The work to do. It gets the resources of the thread running it.
+                /// @param Argument Passed to Function, this must stay valid until the timer is cancelled or expires for the last time.
+                /// @param Delay How many microseconds from now it should first run, it never runs sooner.
+                /// @param Period If not 0, how many microseconds after each expiry it expires again.
+                /// @details Timers are kept in a @ref TimerWheel, so adding and cancelling take the same time however many there
+                /// are, and none is checked individually each frame. A timer expiring during the pause between frames runs on the
+                /// main thread when it expires. One expiring while a frame runs, or when there is no pause, is forked as a task
+                /// at the start of the next frame for any thread to run, like those from a @ref ForkJoinGroup. No timer is
+                /// more precise than @ref MEZZ_TIMERRESOLUTION. This can be called from any thread, including from a timer.
+                /// @return A handle to pass to @ref CancelTimer.
+                virtual TimerHandle AddTimer(ForkedFunction Function, void* Argument, const MaxInt& Delay, const MaxInt& Period = 0);
+
+                /// @brief Stop a timer from expiring again.
+                /// @param Timer A handle returned by @ref AddTimer.
+                /// @details An expiry already forked into the current frame still runs. This can be called from any thread.
+                /// @return True if the timer was cancelled, false if it had already expired for the last time or been cancelled.
+                virtual bool CancelTimer(TimerHandle Timer);
+
+                /// @brief Is a timer still waiting to expire?
+                /// @param Timer A handle returned by @ref AddTimer.
+                /// @return False once it has expired for the last time or been cancelled.
+                virtual bool IsTimerWaiting(TimerHandle Timer);
+
+                /// @brief How many timers are waiting to expire?
+                /// @return A Whole including periodic timers until they are cancelled.
+                virtual Whole GetTimerCount();
+
+                /// @brief How many times has a timer expired?
+                /// @return The count since this was constructed, a periodic timer counts each time.
+                virtual Int32 GetTimerExpiryCount() const;
+
                 ////////////////////////////////////////////////////////////////////////////////
                 // Algorithm essentials
 
                 /// @brief How many other WorkUnit instances must wait on this one.
+                /// @details This counts a WorkUnit once for each chain of dependencies connecting it to Work. Counts are calculated
+                /// for every WorkUnit when the @ref DependentGraph is rebuilt so this is a single lookup.
                 /// @param Work The WorkUnit to get the updated count of.
                 /// @param UsedCachedDepedentGraph If the cache is already up to date leaving this false, and not updating it can save significant time.
                 /// @return A Whole Number representing the amount of WorkUnit instances that cannot start until this finishes.
                 virtual Whole GetDependentCountOf(iWorkUnit *Work, bool UsedCachedDepedentGraph=false);
 
+                /// @brief How many other WorkUnit instances must complete before this one can start.
+                /// @details This counts a WorkUnit once for each chain of dependencies connecting Work to it, like
+                /// @ref iWorkUnit::GetDependencyCount, but from counts calculated for every WorkUnit when the @ref DependentGraph
+                /// is rebuilt. Dependencies of WorkUnits this scheduler does not run are not followed.
+                /// @param Work The WorkUnit to get the updated count of.
+                /// @param UsedCachedDepedentGraph If the cache is already up to date leaving this false, and not updating it can save significant time.
+                /// @return A Whole Number representing the amount of WorkUnit instances that must finish before this starts.
+                virtual Whole GetDependencyCountOf(iWorkUnit *Work, bool UsedCachedDepedentGraph=false);
+
+                /// @brief How long is the longest chain of work that cannot complete until this does?
+                /// @param Work The WorkUnit to get the critical path length of.
+                /// @details This is the execution time of the WorkUnit from its performance log plus the largest critical path
+                /// length of any WorkUnit that depends on it. This is calculated for every WorkUnit at once when the
+                /// @ref DependentGraph is rebuilt and each time the WorkUnitKeys are refreshed.
+                /// @warning This uses the @ref DependentGraph as it is, make sure it is up to date first.
+                /// @return A Whole containing the length of the critical path in microseconds.
+                virtual Whole GetCriticalPathOf(iWorkUnit* Work);
+
                 /// @brief Gets the next available workunit for execution.
                 /// @details This finds the next available WorkUnit which has not started execution, has no dependencies that have
                 /// not complete, has the most WorkUnits that depend on it (has the highest runtime in the case of a tie).
+                /// @n @n
+                /// WorkUnits are published here as their last dependency completes, so this does not need to examine any WorkUnit
+                /// that is still waiting.
                 /// @return A pointer to the WorkUnit that could be executed or a null pointer if that could not be acquired. This does not give ownership of that WorkUnit.
                 virtual iWorkUnit* GetNextWorkUnit();
 
+                /// @brief Gets the next available workunit for execution by a specific thread.
+                /// @details When work stealing this checks the thread's own deque first, then any work published outside a deque,
+                /// then steals from other threads. Otherwise this is the same as @ref GetNextWorkUnit(). Nothing is returned while
+                /// a Monopoly is ready or running.
+                /// @param CurrentThread The resource belonging to the thread asking for work.
+                /// @return A pointer to the WorkUnit that could be executed or a null pointer if that could not be acquired. This does not give ownership of that WorkUnit.
+                virtual iWorkUnit* GetNextWorkUnit(Resource& CurrentThread);
+
                 /// @brief Just like @ref GetNextWorkUnit except that it also searches through and prioritizes work units with affinity too.
                 /// @return A pointer to the WorkUnit that could be executed *in the main thread* or a null pointer if that could not be acquired. This does not give ownership of that WorkUnit.
                 virtual iWorkUnit* GetNextWorkUnitAffinity();
 
+                /// @brief Just like @ref GetNextWorkUnit(Resource&) except that it also searches through and prioritizes work units with affinity too.
+                /// @param CurrentThread The resource belonging to the main thread.
+                /// @return A pointer to the WorkUnit that could be executed *in the main thread* or a null pointer if that could not be acquired. This does not give ownership of that WorkUnit.
+                virtual iWorkUnit* GetNextWorkUnitAffinity(Resource& CurrentThread);
+
                 /// @brief Is the work of the frame done?
+                /// @details This reads the count of outstanding WorkUnits, unless WorkUnits have been added, removed or re-ordered
+                /// since it was last counted. Then every WorkUnit is checked instead.
                 /// @return This returns true if all the WorkUnit instances are complete, and false otherwise.
                 virtual bool AreAllWorkUnitsComplete();
 
+                /// @brief How many WorkUnits still need to complete this frame.
+                /// @return An Int32 that can change at any time during a frame and should be considered stale immediately.
+                virtual Int32 GetOutstandingWorkUnitCount() const;
+
+                /// @brief Block until a WorkUnit completes.
+                /// @param Outstanding The last value read from @ref GetOutstandingWorkUnitCount.
+                /// @details Work can only become ready when other work completes, so a thread that found nothing to do after
+                /// reading the outstanding count can wait here until there might be. Read the count, look for work, then pass
+                /// the count that was read to this. This spins briefly, then yields, then parks the thread until a completing
+                /// WorkUnit makes more work ready or the frame's work is done, see @ref SetIdleSpinCount and @ref SetIdleYieldCount.
+                /// A parked thread is not woken by WorkUnits that complete without making anything ready. While a WorkUnit waits
+                /// on @ref ResumeAt the thread parks no longer than until it is due, and returns then so it can be woken.
+                /// @return The new count of outstanding WorkUnits, 0 when the frame's work is done.
+                virtual Int32 WaitForWorkUnitCompletion(const Int32& Outstanding) const;
+
+                /// @brief Block until every WorkUnit in this frame has completed.
+                virtual void WaitForAllWorkUnits() const;
+
+                /// @brief Run the next frame of one WorkUnit early, if pipelining allows any to start.
+                /// @param CurrentThread The resources of the calling thread.
+                /// @details Threads call this when there is no work left for them in the current frame. The WorkUnit's work is
+                /// done now and it counts as Complete when the next frame starts, see @ref SetFramePipelining.
+                /// @return True if a WorkUnit was run, false if none could start.
+                virtual bool RunWorkUnitAhead(Resource& CurrentThread);
+
+                /// @brief Make a task forked by a running WorkUnit available to every thread, see @ref ForkJoinGroup.
+                /// @param Function The work to do.
+                /// @param Argument Passed to Function.
+                /// @param Pending Raised now and lowered once the task completes.
+                /// @details The task counts as outstanding work until it completes, so threads waiting in
+                /// @ref WaitForWorkUnitCompletion return and can help run it.
+                virtual void ForkTask(ForkedFunction Function, void* Argument, Int32& Pending);
+
+                /// @brief Run the most recently forked task that no thread has started, if there is one.
+                /// @param CurrentThread The resources of the calling thread.
+                /// @details Threads call this before looking for another WorkUnit, so WorkUnits already running finish sooner.
+                /// @return True if a task was run, false if none were waiting.
+                virtual bool RunForkedTask(Resource& CurrentThread);
+
+                /// @brief Run forked tasks until a count raised by @ref ForkTask falls back to 0.
+                /// @param Pending The count passed to ForkTask.
+                /// @param CurrentThread The resources of the calling thread.
+                /// @details Tasks from any group are run while waiting, the calling thread only yields when the remaining
+                /// tasks are all running on other threads.
+                virtual void JoinForkedTasks(Int32& Pending, Resource& CurrentThread);
+
+                /// @brief Called when a WorkUnit completes to release any WorkUnits that were waiting on it.
+                /// @param Completed The WorkUnit that just finished its work.
+                /// @param CompletingThread The resource of the thread that ran the WorkUnit, if known. When work stealing, main
+                /// WorkUnits this releases go onto this thread's deque.
+                /// @details Each direct dependent has its remaining dependency count atomically lowered, and any that reach 0 are
+                /// published for execution. Then the count of outstanding WorkUnits is lowered. WorkUnits this scheduler does not
+                /// know about are ignored.
+                /// @warning An iWorkUnit that does not call this when it completes will keep the frame from ever ending.
+                virtual void ReleaseDependentsOf(iWorkUnit* Completed, Resource* CompletingThread = 0);
+
+                /// @brief Have any thread in this frame continue a suspended @ref ResumableWorkUnit.
+                /// @param Suspended The WorkUnit to run again, this is called by its @ref ResumableWorkUnit::Wake "Wake".
+                /// @details It is forked like a task from a @ref ForkJoinGroup, so the next thread looking for work runs it.
+                virtual void ResumeWorkUnit(ResumableWorkUnit* Suspended);
+
+                /// @brief Wake a suspended @ref ResumableWorkUnit when another WorkUnit in this scheduler completes.
+                /// @param Awaited A WorkUnit this scheduler runs in the current frame.
+                /// @param Suspended The WorkUnit to wake.
+                /// @return False if Awaited had already completed, in which case nothing will wake Suspended.
+                virtual bool ResumeOnCompletion(iWorkUnit* Awaited, ResumableWorkUnit* Suspended);
+
+                /// @brief Wake a suspended @ref ResumableWorkUnit once a timestamp has passed.
+                /// @param WakeTime When to wake it, compared to @ref Mezzanine::GetTimeStamp "GetTimeStamp()".
+                /// @param Suspended The WorkUnit to wake.
+                /// @details Idle threads park only until the earliest WorkUnit waiting this way is due, then return to wake it.
+                virtual void ResumeAt(const MaxInt& WakeTime, ResumableWorkUnit* Suspended);
+
+                /// @brief The task @ref ResumeWorkUnit forks to continue a suspended WorkUnit.
+                /// @param Suspended The ResumableWorkUnit to continue.
+                /// @param CurrentThread The resources of the thread continuing it.
+                static void ResumeSuspendedWorkUnit(void* Suspended, Resource& CurrentThread);
+
+                /// @brief Leave an asynchronous WorkUnit out of this frame while its asynchronous work is still running.
+                /// @param Pending The WorkUnit, which has run this frame and stays @ref Running "Running".
+                /// @details Pending and everything depending on it, directly or not, stop counting toward the outstanding work,
+                /// so the frame can end without them. If @ref FinishAsynchronousWorkUnit is called before it does they count
+                /// again, otherwise Pending is run again next frame like any WorkUnit that did not complete.
+                /// @return False if the asynchronous work was no longer running, in which case Pending completes as usual.
+                virtual bool DeferAsynchronousWorkUnit(iAsynchronousWorkUnit* Pending);
+
+                /// @brief Count a deferred asynchronous WorkUnit and its dependents in this frame again, called once its work completes.
+                /// @param Pending A WorkUnit passed to @ref DeferAsynchronousWorkUnit.
+                /// @return True if Pending was deferred in the frame still running, in which case the caller must mark it
+                /// complete and pass it to @ref ReleaseDependentsOf. False if it was not or that frame has ended.
+                virtual bool FinishAsynchronousWorkUnit(iAsynchronousWorkUnit* Pending);
+
+                /// @brief When the earliest WorkUnit passed to @ref ResumeAt is due.
+                /// @return A timestamp from @ref Mezzanine::GetTimeStamp "GetTimeStamp()", or 0 if none are waiting.
+                MaxInt GetNextResumeTime() const;
+
+                /// @brief Wake every WorkUnit passed to @ref ResumeAt whose time has come.
+                /// @details Threads call this each time they look for work, it does nothing unless a WorkUnit is waiting on time.
+                virtual void ResumeDueWorkUnits();
+
                 /// @brief Create a reverse depedent graph that can be used for sorting Mezzanine::Threading::iWorkUnit "iWorkUnit"s to optimize execution each frame.
                 /// @details This can be called automatically from any of several places that make sense by passing a boolean true value.
                 /// These place include create a @ref WorkUnitKey or Sorting the work units in a framescheduler.
+                /// @n @n
+                /// This also calculates the dependent count and critical path length of every WorkUnit.
                 virtual void UpdateDependentGraph();
 
                 ////////////////////////////////////////////////////////////////////////////////
@@ -357,15 +979,236 @@ namespace Mezzanine
                 /// @param FrameLength The desired minimum length of the frame. Use 0 for no pause.
                 virtual void SetFrameLength(const Whole& FrameLength);
 
+                /// @brief Get the longest a single pause between frames can be.
+                /// @return A Whole in microseconds, defaults to @ref MEZZ_MAXFRAMEWAIT.
+                virtual Whole GetMaximumFrameWait() const;
+
+                /// @brief Limit how long a single pause between frames can be.
+                /// @param MaximumWait The longest pause in microseconds, any longer pause is cut short to this.
+                virtual void SetMaximumFrameWait(const Whole& MaximumWait);
+
+                /// @brief How long before each frame starts does the pause stop sleeping and spin?
+                /// @details The pause sleeps until an absolute deadline on a monotonic clock, then spins for the last
+                /// stretch because operating systems wake sleeping threads late by varying amounts. This margin is
+                /// calibrated from how late the last few wakes were.
+                /// @return A Whole in microseconds.
+                virtual Whole GetFramePacingMargin() const;
+
                 /// @brief Get the amount of threads that will be used to execute WorkUnits a the start of the next frame.
                 /// @return A Whole with the current desired thread count.
                 virtual Whole GetThreadCount();
 
                 /// @brief Set the amount of threads to use.
                 /// @param NewThreadCount The amount of threads to use starting at the begining of the next frame.
-                /// @note Currently the thread count cannot be reduced if Mezz_MinimizeThreadsEachFrame is selected in cmake configuration.
+                /// @note When threads are kept between frames, with a pool or Mezz_MinimizeThreadsEachFrame, extra threads are created or
+                /// retired when the next frame starts. The resources of retired threads are kept for when the thread count grows again.
                 virtual void SetThreadCount(const Whole& NewThreadCount);
 
+                /// @brief Is the thread count being adjusted between frames?
+                /// @return True if the thread count is adaptive, false if it only changes when set.
+                virtual bool GetAdaptiveThreadCount() const;
+
+                /// @brief Enable or disable adjusting the thread count between frames.
+                /// @param Enabled True to adapt the thread count, defaults to false.
+                /// @details When enabled this tracks how long threads wait for work each frame and uses the fewest threads, between
+                /// @ref SetMinimumThreadCount "the minimum" and @ref SetMaximumThreadCount "the maximum", that still finish the work in
+                /// the target frame length. This does nothing when the frame length is 0, because then there is no target to meet.
+                virtual void SetAdaptiveThreadCount(bool Enabled);
+
+                /// @brief What is the fewest threads an adaptive thread count will use?
+                /// @return A Whole with the minimum thread count.
+                virtual Whole GetMinimumThreadCount() const;
+
+                /// @brief Set the fewest threads an adaptive thread count will use.
+                /// @param NewMinimum The minimum, defaults to 1. Values less than 1 are treated as 1.
+                virtual void SetMinimumThreadCount(const Whole& NewMinimum);
+
+                /// @brief What is the most threads an adaptive thread count will use?
+                /// @return A Whole with the maximum thread count.
+                virtual Whole GetMaximumThreadCount() const;
+
+                /// @brief Set the most threads an adaptive thread count will use.
+                /// @param NewMaximum The maximum, defaults to the value returned by @ref Mezzanine::GetCPUCount "GetCPUCount()".
+                virtual void SetMaximumThreadCount(const Whole& NewMaximum);
+
+                /// @brief Is each thread keeping its own deque of ready work and stealing when it runs out?
+                /// @return True if work stealing is enabled, false if all threads share one pool of ready work.
+                virtual bool GetWorkStealing() const;
+
+                /// @brief Enable or disable work stealing starting with the next frame.
+                /// @param Enabled True to give each thread its own deque of ready work, false to share one pool. Defaults to false.
+                /// @details With work stealing the work a thread makes ready stays on that thread unless another thread runs
+                /// out and steals it. This keeps threads off of each others cache lines and should scale better to
+                /// large thread counts. Without it every thread acquires work from one shared priority queue.
+                /// @warning Do not change this while a frame is running.
+                virtual void SetWorkStealing(bool Enabled);
+
+                /// @brief Are WorkUnits sorted primarily by the length of the chain of work behind them?
+                /// @return True if sorting by critical path, false if sorting by dependent count first.
+                virtual bool GetCriticalPathSorting() const;
+
+                /// @brief Choose what the next sort of the WorkUnits prioritizes.
+                /// @param Enabled True to sort by critical path, false to sort by dependent count. Defaults to false.
+                /// @details The dependent count prioritizes WorkUnits that many others wait on, but a long serial chain of slow
+                /// WorkUnits waiting on one WorkUnit counts the same as a few quick ones. Sorting by critical path weights each
+                /// chain by the measured execution times of its WorkUnits, so the work most likely to determine the length of the
+                /// frame starts first. This affects @ref SortWorkUnitsMain, @ref SortWorkUnitsAffinity, @ref SortWorkUnitsAll and
+                /// the @ref WorkSorter.
+                virtual void SetCriticalPathSorting(bool Enabled);
+
+                /// @brief Can WorkUnits start their next frame before the current frame ends?
+                /// @return True if frames are pipelined, false if each frame finishes before the next starts.
+                virtual bool GetFramePipelining() const;
+
+                /// @brief Allow idle threads near the end of a frame to start work from the next frame.
+                /// @param Enabled True to pipeline frames, defaults to false.
+                /// @details Normally each frame must end before any work in the next starts, so threads sit idle while the last
+                /// WorkUnits of a frame finish. When pipelining, a thread with nothing left to do in the current frame starts the
+                /// next frame of a WorkUnit passed to @ref SetWorkUnitPipelined once all of these hold:
+                ///     - Its own work for the current frame is complete.
+                ///     - Its dependencies have completed their next frame early, so order within a frame is kept.
+                ///     - Each dependency added with @ref AddCrossFrameDependency has completed its current frame.
+                /// @n At most two frames are in flight. The current frame still waits for every WorkUnit, including any
+                /// started early, and those count as complete when the next frame starts. WorkUnits that read data another
+                /// WorkUnit writes, or write data another WorkUnit reads later in the frame, need a cross-frame dependency on it.
+                /// @warning Do not change this while a frame is running.
+                virtual void SetFramePipelining(bool Enabled);
+
+                /// @brief Allow or disallow a WorkUnit to start its next frame early when pipelining.
+                /// @param Unit A main WorkUnit on this scheduler. Affinity WorkUnits and Monopolies never start early.
+                /// @param Pipelined True to allow it, false to have it wait for the next frame like any other WorkUnit.
+                virtual void SetWorkUnitPipelined(iWorkUnit* Unit, bool Pipelined = true);
+
+                /// @brief Is a WorkUnit allowed to start its next frame early?
+                /// @param Unit The WorkUnit to check.
+                /// @return True if it was passed to @ref SetWorkUnitPipelined, false otherwise.
+                virtual bool IsWorkUnitPipelined(iWorkUnit* Unit) const;
+
+                /// @brief Keep the next frame of a WorkUnit from starting early until another completes its current frame.
+                /// @param Dependent The WorkUnit that would start early.
+                /// @param Dependency The WorkUnit whose current frame must complete first.
+                /// @details Without pipelining every frame is complete before the next starts, so these are always satisfied.
+                virtual void AddCrossFrameDependency(iWorkUnit* Dependent, iWorkUnit* Dependency);
+
+                /// @brief Remove a dependency added with @ref AddCrossFrameDependency.
+                /// @param Dependent The WorkUnit that would start early.
+                /// @param Dependency The WorkUnit it should no longer wait on.
+                virtual void RemoveCrossFrameDependency(iWorkUnit* Dependent, iWorkUnit* Dependency);
+
+                /// @brief How many times has a WorkUnit started its next frame early?
+                /// @return The count since this was constructed.
+                virtual Int32 GetEarlyStartCount() const;
+
+                /// @brief Passed as the phase to @ref SetWorkUnitPeriod to have this scheduler choose it.
+                static const Whole AutomaticPhase;
+
+                /// @brief Run a WorkUnit only once every few frames.
+                /// @param Unit A WorkUnit on this scheduler.
+                /// @param Period How many frames pass between each run, 0 or 1 to run every frame.
+                /// @param Phase Which of those frames it runs on, it runs when the frame count divided by Period leaves this
+                /// remainder. By default this scheduler chooses the phase so WorkUnits with the same period take turns.
+                /// @details On frames a WorkUnit is skipped it counts as Complete from the start, so it takes no time from any
+                /// thread and WorkUnits depending on it do not wait for it. They use whatever it produced the last time it ran.
+                /// Automatically chosen phases can change when any WorkUnit's period is set or it is removed. WorkUnits that do
+                /// not run every frame are never pipelined. This takes effect for the frame after the next reset.
+                virtual void SetWorkUnitPeriod(iWorkUnit* Unit, const Whole& Period, const Whole& Phase = AutomaticPhase);
+
+                /// @brief How often does a WorkUnit run?
+                /// @param Unit The WorkUnit to check.
+                /// @return How many frames pass between each run, 1 if it runs every frame.
+                virtual Whole GetWorkUnitPeriod(iWorkUnit* Unit) const;
+
+                /// @brief Which frames does a WorkUnit run on?
+                /// @param Unit The WorkUnit to check.
+                /// @return The remainder the frame count divided by its period leaves on frames it runs, 0 if it runs every frame.
+                virtual Whole GetWorkUnitPhase(iWorkUnit* Unit) const;
+
+                /// @brief Allow a WorkUnit to be skipped on frames that would otherwise miss their deadline.
+                /// @param Unit A WorkUnit on this scheduler.
+                /// @param Priority When some must be shed the ones with the lowest priority go first.
+                /// @details Before each frame the work it will take is predicted from every WorkUnit's performance log. If that
+                /// will not fit in what is left of the target frame length, optional WorkUnits are marked Complete without
+                /// running until it does, and their dependents use whatever they produced last. A WorkUnit's priority grows each
+                /// frame it is shed, so it is deferred rather than starved. Optional WorkUnits are never pipelined.
+                virtual void SetWorkUnitOptional(iWorkUnit* Unit, const Integer& Priority = 0);
+
+                /// @brief Require a WorkUnit to run every frame it is scheduled, this is the default.
+                /// @param Unit A WorkUnit that may have been made optional.
+                virtual void SetWorkUnitMandatory(iWorkUnit* Unit);
+
+                /// @brief Can a WorkUnit be shed when the frame is overloaded?
+                /// @param Unit The WorkUnit to check.
+                /// @return True if @ref SetWorkUnitOptional was called for it.
+                virtual bool IsWorkUnitOptional(iWorkUnit* Unit) const;
+
+                /// @brief How many times has an optional WorkUnit been shed?
+                /// @return The count since this was constructed.
+                virtual Whole GetShedCount() const;
+
+                /// @brief How are threads assigned to logical processors?
+                /// @return The ThreadAffinityPolicy most recently set, NoAffinity by default.
+                virtual ThreadAffinityPolicy GetThreadAffinity() const;
+
+                /// @brief Pin the main thread and each worker to logical processors chosen from the CPU topology.
+                /// @param Policy How to order the logical processors returned by @ref Mezzanine::GetCPUTopology "GetCPUTopology()". NoAffinity
+                /// lets threads run anywhere again. ExplicitAffinity keeps using the current list of logical processors.
+                /// @details Threads pin themselves when the next frame starts. Pinning keeps a thread's cache warm between frames,
+                /// and the policy controls whether threads share caches (compact) or have as much cache and bandwidth to themselves
+                /// as possible (scatter or physical cores first). This only has an effect on Linux and Windows.
+                /// @warning Do not change this while a frame is running.
+                virtual void SetThreadAffinity(ThreadAffinityPolicy Policy);
+
+                /// @brief Pin the main thread and each worker to logical processors from a list.
+                /// @param CPUs The operating system's IDs of logical processors, the main thread uses the first, the first worker the
+                /// second and so on, wrapping if there are more threads. An empty list is the same as NoAffinity.
+                /// @warning Do not change this while a frame is running.
+                virtual void SetThreadAffinity(const std::vector<Whole>& CPUs);
+
+                /// @brief Which logical processor will each thread be pinned to?
+                /// @details While threads are pinned, each thread's @ref ThreadSpecificStorage is moved to the NUMA node of its
+                /// logical processor, by reallocating it from that thread. With @ref SetWorkStealing "work stealing" each WorkUnit
+                /// ready at the start of a frame is given to a thread on the node it last ran on, and threads steal from others
+                /// on their own node first.
+                /// @return A vector of logical processor IDs, thread N uses entry N modulo its size. Empty when threads are not pinned.
+                virtual const std::vector<Whole>& GetThreadAffinityCPUs() const;
+
+                /// @brief How many times has a thread failed to apply the affinity?
+                /// @details The operating system can refuse to pin a thread, for instance to a logical processor that is offline
+                /// or outside the process's allowed set. A thread that fails is not treated as pinned, it tries again each frame
+                /// and adds to this every time.
+                /// @return The count since this was constructed.
+                virtual Whole GetThreadAffinityFailureCount() const;
+
+                /// @brief Which kind of barrier was chosen at construction to synchronize threads between frames?
+                /// @return The BarrierAlgorithm passed to the constructor. This only has an effect if Mezz_MinimizeThreadsEachFrame was enabled.
+                virtual BarrierAlgorithm GetBarrierAlgorithm() const;
+
+                /// @brief How many times does a thread with nothing to do check for more work before yielding?
+                /// @return A Whole with the count of checks.
+                virtual Whole GetIdleSpinCount() const;
+
+                /// @brief Set how many times a thread with nothing to do checks for more work without giving up the CPU.
+                /// @param Count The amount of checks, defaults to 256.
+                /// @details Spinning costs CPU time but notices new work fastest. Narrow parts of a graph leave most threads with
+                /// nothing to do, and while they spin they compete with the threads doing the work.
+                virtual void SetIdleSpinCount(const Whole& Count);
+
+                /// @brief How many times does a thread with nothing to do yield after spinning, before it parks?
+                /// @return A Whole with the count of yields.
+                virtual Whole GetIdleYieldCount() const;
+
+                /// @brief Set how many times a thread with nothing to do yields before it is parked.
+                /// @param Count The amount of yields, defaults to 8.
+                /// @details A parked thread uses no CPU time at all, but waking it takes a system call and however long the OS
+                /// takes to schedule it again. Lower this and @ref SetIdleSpinCount to use less CPU time in frames with little
+                /// parallel work, raise them to pick up new work sooner.
+                virtual void SetIdleYieldCount(const Whole& Count);
+
+                /// @brief How many times have threads been parked waiting for work?
+                /// @details Compare this between frames with the frame times to weigh CPU time saved against latency.
+                /// @return An Int32 that counts every park since this FrameScheduler was created.
+                virtual Int32 GetIdleParkCount() const;
+
                 /// @brief When did this frame start?
                 /// @return A MaxInt with the timestamp corresponding to when this frame started.
                 virtual MaxInt GetCurrentFrameStart() const;
@@ -395,7 +1238,6 @@ namespace Mezzanine
                 /// @code
                 /// void FrameScheduler::DoOneFrame()
                 /// {
-                ///   RunAllMonopolies();
                 ///   CreateThreads();
                 ///   RunMainThreadWork();
                 ///   JoinAllThreads();
@@ -410,20 +1252,17 @@ namespace Mezzanine
                 /// (except Monopolies) or you want to take the most recent performance number into account.
                 virtual void DoOneFrame();
 
-                // Image that the next 6 functions should be call in sequence for ideal performance.
+                // Image that the next 5 functions should be call in sequence for ideal performance.
                 // Do preparation here.
 
-                // Setup anything monopolies need, though it would be better if the monopolies could do it themselves in a multithreaded way.
-
-                /// @brief This is the 1st step (of 6) in a frame.
-                /// @details This iterates over the listing of @ref MonopolyWorkUnit "MonopolyWorkUnit"s and executes each one in the order
-                /// it was added. This should be considered as consuming all available CPU time until it returns. This call blocks until execution
-                /// of monopolies is complete.
+                /// @brief An optional step before the 1st in a frame, runs Monopolies on the calling thread alone.
+                /// @details This runs each @ref MonopolyWorkUnit "MonopolyWorkUnit" that does not wait on another WorkUnit, in the order
+                /// they were added, with a @ref ThreadTeam of only the calling thread. @ref DoOneFrame does not call this, Monopolies
+                /// normally run during the frame where every thread joins their team. Any that run here are already Complete when the
+                /// frame starts.
                 virtual void RunAllMonopolies();
 
-                // If the monopolies need some cleanup, it could be done here. Not much should be done here, most work is better as a work unit.
-
-                /// @brief This is the 2nd step (of 6) in a frame.
+                /// @brief This is the 1st step (of 5) in a frame.
                 /// @details This starts all the threads on their work. Until @ref JoinAllThreads() is called some thread may still be working.
                 /// This thread starts the man @ref algorithm_sec "scheduling algorithm" working on every thread except the calling thread. This
                 /// call does not block and tends to return very quickly.
@@ -436,9 +1275,10 @@ namespace Mezzanine
                 /// @n @n
                 /// If the build option
                 /// @ref MEZZ_USEBARRIERSEACHFRAME Mezz_MinimizeThreadsEachFrame was enabled then this will reuse threads from previous frames,
-                /// otherwise this will re-use thread specific resources and create a new set of threads. Re-use of threads is synchronized
-                /// with the @ref Barrier StartFrameSync member variable. It is unclear, and likely platform specific, which option has
-                /// better performance characteristics.
+                /// synchronized with the @ref Barrier StartFrameSync member variable. If Mezz_CreateThreadsEachFrame was enabled this will
+                /// re-use thread specific resources and create a new set of threads. Otherwise, by default, this wakes the pool of threads
+                /// parked since the last frame, creating any more that are needed. It is unclear, and likely platform specific, which
+                /// option has better performance characteristics.
                 /// @warning While this is running any changes to the @ref FrameScheduler must be made with an atomic operation like the
                 /// @ref AtomicCompareAndSwap32 "AtomicCompareAndSwap32" or @ref AtomicAdd "AtomicAdd". Any other threads
                 /// workunit may be accessed as any normal shared data, but Thread specific Resources should not be accessed while this runs.
@@ -449,7 +1289,7 @@ namespace Mezzanine
                 // If it must be run on the main thread and must be run first each frame it could go here, but I think you should
                 // just make a work unit out of it and make other work units depend on it. Right now all the other thread are working.
 
-                /// @brief This is the 3rd step (of 6) in a frame.
+                /// @brief This is the 2nd step (of 5) in a frame.
                 /// @details This runs the main portion of the @ref algorithm_sec "scheduling algorithm" on the main thread. This call
                 /// blocks until the execution of all workunits with main thread affinity are complete and all other work units have at
                 /// least started. This could return and other threads could still be working.
@@ -465,7 +1305,7 @@ namespace Mezzanine
                 // have finished. But if you must do something after all the workunits have started and most finished, while the threads
                 // remain in memory, then this is the place to do it.
 
-                /// @brief This is the 4th step (of 6) in a frame.
+                /// @brief This is the 3rd step (of 5) in a frame.
                 /// @details Used when completing the work of a frame, to cleaning end the execution of the threads. This function will
                 /// only return when all the work started by @ref CreateThreads() and @ref RunMainThreadWork() have completed. This call
                 /// blocks until all threads executing. If a thread takes too long then this simply waits for it to finish. No attempt is
@@ -476,22 +1316,27 @@ namespace Mezzanine
                 // and maybe other kinds of work. but maybe that stuff could go in a monopoly instead. This might be a good place to check
                 // statuses of work units, but all the interesting statuses kill the program.
 
-                /// @brief This is the 5th step (of 6) in a frame.
+                /// @brief This is the 4th step (of 5) in a frame.
                 /// @details Take any steps required to prepare all owned WorkUnits for execution next frame. This usually includes reseting
                 /// all the work units running state to @ref NotStarted "NotStarted". This can cause work units to be executed multiple times
                 /// if a thread is still executing.
+                /// @n @n
+                /// WorkUnits that follow the frame epoch are reset all at once by advancing it, and each one restored its remaining
+                /// dependency count as it completed. So after a normal frame this does not touch any of those WorkUnits. Only if the
+                /// dependencies changed or some WorkUnits did not complete is every remaining dependency counted again.
                 virtual void ResetAllWorkUnits();
 
                 // All the work units are ready for the next frame, but no real waiting has occurred yet.
 
-                /// @brief This is the final step (of 6) in a frame.
+                /// @brief This is the final step (of 5) in a frame.
                 /// @details Wait until this frame has consumed its fair share of a second. This uses the value passed in
                 /// @ref SetFrameRate "SetFrameRate" to determine what portion of a second each frame should
                 /// use. If a frame took too long to execute this calculates that and returns.
                 /// @n @n
                 /// Wait 1/TargetFrame seconds, minus time already run. This also starts the timer for the next frame so
-                /// any other logic that needs to run after the frame does not interfere with frame timing. Because
-                /// This is designed to wait fractions of a second any amount of waiting above 1 second fails automaticall.
+                /// any other logic that needs to run after the frame does not interfere with frame timing. Any pause longer
+                /// than @ref SetMaximumFrameWait "the maximum frame wait" is cut short to it. The pause sleeps until an
+                /// absolute deadline and spins for the last @ref GetFramePacingMargin "few microseconds" so frames start on time.
                 void WaitUntilNextFrame();
 
                 // This is the same place as before the monopolies, except for whatever one time setup code you might have.
@@ -503,6 +1348,10 @@ namespace Mezzanine
                 /// @return A Whole containing this amount
                 Whole GetWorkUnitMonopolyCount() const;
 
+                /// @brief Returns the amount of iWorkUnit run in the pause between frames
+                /// @return A Whole containing this amount
+                Whole GetWorkUnitBackgroundCount() const;
+
                 /// @brief Returns the amount of iWorkUnit ready to be scheduled in the Affinity pool
                 /// @return A Whole containing this amount
                 Whole GetWorkUnitAffinityCount() const;
@@ -530,6 +1379,12 @@ namespace Mezzanine
                 /// and carefully or inside a frame and only from the owning thread.
                 Resource* GetThreadResource(ThreadId ID = this_thread::get_id());
 
+                /// @brief Get the threads lent to the running Monopoly.
+                /// @details During a frame every thread this scheduler uses is in the team, otherwise only the thread
+                /// running the Monopoly is.
+                /// @return A reference to the ThreadTeam a @ref MonopolyWorkUnit can use in its DoWork.
+                ThreadTeam& GetThreadTeam();
+
                 /// @brief Get the logger safe to use this thread.
                 /// @warning This is written in terms of GetThreadResource and has all the
                 /// same limitations.
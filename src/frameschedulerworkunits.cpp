@@ -44,6 +44,8 @@
 #include "frameschedulerworkunits.h"
 #include "doublebufferedresource.h"
 
+#include <algorithm>
+
 /// @file
 /// @brief The implementation of any workunits the framescheduler needs to work correctly
 
@@ -107,8 +109,10 @@ namespace Mezzanine
                 WorkUnitsAffinity.clear();
                 WorkUnitsMain.insert(WorkUnitsMain.end(),FS.WorkUnitsMain.begin(),FS.WorkUnitsMain.end());
                 FS.UpdateWorkUnitKeys(WorkUnitsMain);
+                std::sort(WorkUnitsMain.begin(),WorkUnitsMain.end(),std::less<WorkUnitKey>() );
                 WorkUnitsAffinity.insert(WorkUnitsAffinity.end(),FS.WorkUnitsAffinity.begin(),FS.WorkUnitsAffinity.end());
                 FS.UpdateWorkUnitKeys(WorkUnitsAffinity);
+                std::sort(WorkUnitsAffinity.begin(),WorkUnitsAffinity.end(),std::less<WorkUnitKey>() );
                 FS.Sorter = this;
             }else{
                 #ifdef MEZZ_DEBUG
@@ -42,6 +42,7 @@
 #define _threadmonopoly_cpp
 
 #include "monopoly.h"
+#include "framescheduler.h"
 
 /// @file
 /// @brief Contains the minimal implementation for the monopoly base class
@@ -50,6 +51,16 @@ namespace Mezzanine
 {
     namespace Threading
     {
+        void MonopolyWorkUnit::operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            FrameScheduler* Scheduler = CurrentThreadStorage.GetFrameScheduler();
+            if(Scheduler)
+                { Scheduler->GetThreadTeam().Assemble(CurrentThreadStorage); }
+            DefaultWorkUnit::operator()(CurrentThreadStorage);
+            if(Scheduler)
+                { Scheduler->GetThreadTeam().Dismiss(); }
+        }
+
         MonopolyWorkUnit::~MonopolyWorkUnit()
             {}
     }//Threading
@@ -58,10 +58,17 @@ namespace Mezzanine
         class FrameScheduler;
 
         /// @brief A kind of workunit given exclusive runtime so it can consume time on multiple threads
-        /// @details A @ref FrameScheduler executes monopolies before other and will allow them to run with on every thread.
+        /// @details A @ref FrameScheduler runs a Monopoly on the main thread once its dependencies are complete, like a WorkUnit
+        /// with affinity. No other WorkUnit starts while one is waiting to run or running, and every other thread the scheduler
+        /// is using this frame joins its @ref ThreadTeam instead. A Monopoly with no dependencies runs before any other work
+        /// in the frame. Use @ref FrameScheduler::GetThreadTeam "GetThreadTeam()" in DoWork to put the team to work.
         class MEZZ_LIB MonopolyWorkUnit : public DefaultWorkUnit
         {
             public:
+                /// @brief Gathers the scheduler's @ref ThreadTeam, does the work then dismisses the team.
+                /// @param CurrentThreadStorage The resources of the thread running this, which leads the team.
+                virtual void operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage);
+
                 /// @brief Provides a hint to the monopoly as to how many threads it should use.
                 /// @param AmountToUse The amount of threads you would like the monopoly to consume.
                 virtual void UseThreads(const Whole& AmountToUse) = 0;
@@ -0,0 +1,164 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _resumableworkunit_cpp
+#define _resumableworkunit_cpp
+
+#include "resumableworkunit.h"
+#include "asynchronousworkunit.h"
+#include "atomicoperations.h"
+#include "framescheduler.h"
+#include "systemcalls.h"
+
+/// @file
+/// @brief Contains the implementation for the @ref Mezzanine::Threading::ResumableWorkUnit ResumableWorkUnit.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        ResumableWorkUnit::ResumableWorkUnit() :
+            ResumePoint(0),
+            Suspension(0),
+            Scheduler(0),
+            WorkTime(0)
+            {}
+
+        ResumableWorkUnit::~ResumableWorkUnit()
+            {}
+
+        void ResumableWorkUnit::BeginSuspension()
+            { AtomicCompareAndSwap32(&Suspension,0,1); }
+
+        void ResumableWorkUnit::CancelSuspension()
+            { AtomicCompareAndSwap32(&Suspension,1,0); }
+
+        bool ResumableWorkUnit::AwaitAsynchronousWork(iAsynchronousWorkUnit& Awaited, Whole NextPoint)
+        {
+            ResumePoint = NextPoint;
+            if(!Scheduler)
+            {
+                Awaited.WaitForAsynchronousWork();
+                return false;
+            }
+            BeginSuspension();
+            if(Awaited.ResumeWhenComplete(this))
+                { return true; }
+            CancelSuspension();
+            return false;
+        }
+
+        bool ResumableWorkUnit::AwaitWorkUnit(iWorkUnit& Awaited, Whole NextPoint)
+        {
+            ResumePoint = NextPoint;
+            if(!Scheduler)
+            {
+                while(Complete>Awaited.GetRunningState())
+                    { this_thread::yield(); }
+                return false;
+            }
+            BeginSuspension();
+            if(Scheduler->ResumeOnCompletion(&Awaited,this))
+                { return true; }
+            CancelSuspension();
+            return false;
+        }
+
+        bool ResumableWorkUnit::AwaitTime(const MaxInt& WakeTime, Whole NextPoint)
+        {
+            ResumePoint = NextPoint;
+            if(!Scheduler)
+            {
+                this_thread::sleep_until(WakeTime);
+                return false;
+            }
+            if(WakeTime<=Mezzanine::GetTimeStamp())
+                { return false; }
+            BeginSuspension();
+            Scheduler->ResumeAt(WakeTime,this);
+            return true;
+        }
+
+        void ResumableWorkUnit::Wake()
+        {
+            Int32 Previous = AtomicCompareAndSwap32(&Suspension,1,3);
+            if(2==Previous && 2==AtomicCompareAndSwap32(&Suspension,2,0))
+                { Scheduler->ResumeWorkUnit(this); }
+        }
+
+        bool ResumableWorkUnit::IsSuspended() const
+            { return 2==AtomicAdd(const_cast<Int32*>(&Suspension),0); }
+
+        void ResumableWorkUnit::operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            std::ostream& Out = CurrentThreadStorage.GetUsableLogger();
+            Out << "<WorkUnit id=\"" << std::hex << this << std::dec << "\">" << std::endl;
+
+            Scheduler = CurrentThreadStorage.GetFrameScheduler();
+            for(;;)
+            {
+                MaxInt Begin = Mezzanine::GetTimeStamp();
+                this->DoWork(CurrentThreadStorage);
+                WorkTime += Whole(Mezzanine::GetTimeStamp()-Begin);
+                if(0==AtomicAdd(&Suspension,0))
+                    { break; }
+
+                Whole SuspendedAt = ResumePoint; // Once suspended another thread may continue this at any moment
+                if(1==AtomicCompareAndSwap32(&Suspension,1,2))
+                {
+                    Out << "<WorkUnitSuspended ResumePoint=\"" << SuspendedAt << "\" />" << std::endl
+                        << "</WorkUnit>" << std::endl;
+                    return;
+                }
+                AtomicCompareAndSwap32(&Suspension,3,0); // Woken while returning, so continue on this thread
+            }
+
+            ResumePoint = 0;
+            this->GetPerformanceLog().Insert(WorkTime);
+            WorkTime = 0;
+            CurrentRunningState = TagRunningState(Complete);
+            if(Scheduler)
+                { Scheduler->ReleaseDependentsOf(this, &CurrentThreadStorage); }
+            Out << "</WorkUnit>" << std::endl;
+        }
+    }//Threading
+}//Mezzanine
+
+#endif
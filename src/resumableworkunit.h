@@ -0,0 +1,137 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _resumableworkunit_h
+#define _resumableworkunit_h
+
+#include "datatypes.h"
+
+#if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
+#include "workunit.h"
+#endif
+
+/// @file
+/// @brief Contains the declaration of the @ref Mezzanine::Threading::ResumableWorkUnit ResumableWorkUnit that can wait without holding a thread.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        class iAsynchronousWorkUnit;
+
+        /// @brief A WorkUnit that can suspend partway through its work and be continued later by any thread.
+        /// @details Any WorkUnit that waits, such as on a file load, keeps the thread running it from doing anything else.
+        /// When one of these waits, @ref DoWork returns instead and the thread moves on to other work. When the thing it
+        /// waited on is ready, whichever thread first looks for work calls DoWork again to continue it.
+        /// @n @n
+        /// DoWork continues from @ref ResumePoint, which is 0 the first time it is called each frame. A derived class
+        /// usually switches on it and has a case for each place it can continue from. Each of the Await methods sets
+        /// ResumePoint to the point given and returns true if this is suspended, in which case DoWork must return right away.
+        /// When they return false whatever was awaited is already ready and DoWork can carry on, usually by falling through
+        /// to the next case. Locals do not survive a suspension, so anything needed after one must be a member.
+        /// @n @n
+        /// The frame does not end and dependents are not released until DoWork returns without suspending. Outside a
+        /// @ref FrameScheduler, such as in a test, the Await methods block the calling thread and always return false.
+        /// @warning Do not await a WorkUnit that depends on this one, or one the scheduler will not run this frame, the
+        /// frame would never end. These should not be pipelined with @ref FrameScheduler::SetFramePipelining "SetFramePipelining".
+        class MEZZ_LIB ResumableWorkUnit : public DefaultWorkUnit
+        {
+            protected:
+                /// @brief Where @ref DoWork should continue from, 0 when it has not started or after it completes.
+                Whole ResumePoint;
+
+                /// @brief Settles a suspension between this and whatever wakes it.
+                /// @details 0 while running, 1 while DoWork is returning to suspend, 2 once suspended and 3 when woken
+                /// before DoWork finished returning, in which case the same thread continues it.
+                Int32 Suspension;
+
+                /// @brief The scheduler running this, or 0 if there is none.
+                FrameScheduler* Scheduler;
+
+                /// @brief Time spent in DoWork so far this frame, in microseconds.
+                Whole WorkTime;
+
+                /// @brief Mark this as about to suspend, called before registering with whatever will wake it.
+                void BeginSuspension();
+
+                /// @brief Undo @ref BeginSuspension when whatever would have woken this is already ready.
+                void CancelSuspension();
+
+                /// @brief Continue once some asynchronous work completes.
+                /// @param Awaited The asynchronous WorkUnit whose work to wait on.
+                /// @param NextPoint Where DoWork continues from.
+                /// @return True if this is suspended and DoWork must return, false if the work was not running.
+                bool AwaitAsynchronousWork(iAsynchronousWorkUnit& Awaited, Whole NextPoint);
+
+                /// @brief Continue once another WorkUnit in the same scheduler has completed this frame.
+                /// @param Awaited The WorkUnit to wait on.
+                /// @param NextPoint Where DoWork continues from.
+                /// @return True if this is suspended and DoWork must return, false if Awaited had already completed.
+                bool AwaitWorkUnit(iWorkUnit& Awaited, Whole NextPoint);
+
+                /// @brief Continue once a timestamp has passed.
+                /// @param WakeTime When to continue, compared to @ref Mezzanine::GetTimeStamp "GetTimeStamp()".
+                /// @param NextPoint Where DoWork continues from.
+                /// @return True if this is suspended and DoWork must return, false if WakeTime has passed.
+                bool AwaitTime(const MaxInt& WakeTime, Whole NextPoint);
+
+            public:
+                /// @brief Constructor
+                ResumableWorkUnit();
+
+                /// @brief Virtual Deconstructor
+                virtual ~ResumableWorkUnit();
+
+                /// @brief Continue this on any thread, called by whatever it awaits once that is ready.
+                void Wake();
+
+                /// @brief Is this suspended waiting on something?
+                /// @return True from the moment DoWork returns to suspend until it is woken.
+                bool IsSuspended() const;
+
+                /// @brief Call DoWork from the ResumePoint and complete unless it suspended.
+                /// @param CurrentThreadStorage The resources of the thread running or continuing this.
+                /// @details Time spent suspended is not counted in the performance log, only time spent in DoWork.
+                virtual void operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage);
+        };//ResumableWorkUnit
+    }//Threading
+}//Mezzanine
+
+#endif
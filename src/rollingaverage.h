@@ -236,9 +236,10 @@ namespace Mezzanine
             virtual void Insert(RecordType Datum)
             {
                 LastEntry = Datum;
-                CurrentAverage = ( MathType(this->CurrentAverage) ? MathType(this->CurrentAverage) : MathType(1)) // A zero really screws with averages that tend to move away from zero
-                        * ((MathType(MEZZ_FRAMESTOTRACK)-MathType(1))/MathType(MEZZ_FRAMESTOTRACK))               // Get weight of all the older members
-                        + MathType(Datum)/MathType(MEZZ_FRAMESTOTRACK);                                           // wGet the Weight of the Current Member
+                CurrentAverage = ( ( MathType(this->CurrentAverage) ? MathType(this->CurrentAverage) : MathType(1)) // A zero really screws with averages that tend to move away from zero
+                        * (MathType(MEZZ_FRAMESTOTRACK)-MathType(1))                                              // Get weight of all the older members
+                        + MathType(Datum) )                                                                       // Get the Weight of the Current Member
+                        / MathType(MEZZ_FRAMESTOTRACK);                                                           // Divide last so integer math keeps the older members
             }
 
             /// @brief Get the current rolling average.
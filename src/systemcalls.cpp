@@ -58,10 +58,19 @@
             #include <sys/sysctl.h>
         #endif
         #include <sys/time.h>
+        #include <time.h>
         #include <unistd.h>
     #endif
 #endif
 
+#ifdef __linux__
+    #include <dirent.h>
+    #include <cstdlib>
+    #include <cstring>
+    #include <fstream>
+    #include <sstream>
+#endif
+
 namespace Mezzanine
 {
     #ifdef _MEZZ_CPP11_
@@ -98,15 +107,32 @@ namespace Mezzanine
                 { return Whole(ATimer.frequency.QuadPart/1000); }
 
         #else
+            #ifdef CLOCK_MONOTONIC
+            MaxInt GetTimeStamp()
+            {
+                timespec Now;
+                clock_gettime(CLOCK_MONOTONIC, &Now); // Unlike the wall clock this never jumps when the system time is set
+                return (MaxInt(Now.tv_sec) * 1000000) + Now.tv_nsec/1000;
+            }
+
+            Whole GetTimeStampResolution()
+            {
+                timespec Resolution;
+                if(clock_getres(CLOCK_MONOTONIC, &Resolution) || Resolution.tv_sec || Resolution.tv_nsec<1000)
+                    { return 1; }
+                return Whole(Resolution.tv_nsec/1000);
+            }
+            #else
             MaxInt GetTimeStamp()
             {
                 timeval Now;
                 gettimeofday(&Now, NULL); // Posix says this must return 0, so it seems it can't fail
-                return (Now.tv_sec * 1000000) + Now.tv_usec;
+                return (MaxInt(Now.tv_sec) * 1000000) + Now.tv_usec;
             }
 
             Whole GetTimeStampResolution()
                 { return 1; } // barring kernel bugs
+            #endif
 
         #endif
     #endif
@@ -244,6 +270,101 @@ namespace Mezzanine
         #endif
     }
 
+    #ifdef __linux__
+    namespace
+    {
+        /// @internal
+        /// @brief Read a single number from a file in sysfs.
+        /// @param Path The file to read.
+        /// @param Result Where to put the number, unchanged if it could not be read.
+        /// @return True if a number was read.
+        bool ReadSysfsWhole(const std::string& Path, Whole& Result)
+        {
+            std::ifstream File(Path.c_str());
+            Whole Value;
+            if(File >> Value)
+            {
+                Result = Value;
+                return true;
+            }
+            return false;
+        }
+
+        /// @internal
+        /// @brief Find the NUMA node of a logical processor from the nodeN link in its sysfs directory.
+        /// @param Path The sysfs directory of the logical processor.
+        /// @param Result Where to put the node, unchanged if it could not be found.
+        void ReadSysfsNode(const std::string& Path, Whole& Result)
+        {
+            DIR* Directory = opendir(Path.c_str());
+            if(!Directory)
+                { return; }
+            for(dirent* Entry = readdir(Directory); Entry; Entry = readdir(Directory))
+            {
+                if(0==strncmp(Entry->d_name,"node",4) && '0'<=Entry->d_name[4] && Entry->d_name[4]<='9')
+                {
+                    Result = Whole(strtoul(Entry->d_name+4,0,10));
+                    break;
+                }
+            }
+            closedir(Directory);
+        }
+    }
+    #endif
+
+    std::vector<LogicalCPU> GetCPUTopology()
+    {
+        std::vector<LogicalCPU> Results;
+        #ifdef __linux__
+            // The online list looks like "0-3,6,8-11"
+            std::ifstream Online("/sys/devices/system/cpu/online");
+            std::string Ranges;
+            if(std::getline(Online, Ranges))
+            {
+                std::stringstream RangeStream(Ranges);
+                std::string Range;
+                while(std::getline(RangeStream, Range, ','))
+                {
+                    Whole First = 0, Last = 0;
+                    char Dash = 0;
+                    std::stringstream Parser(Range);
+                    if(!(Parser >> First))
+                        { continue; }
+                    if(!(Parser >> Dash >> Last) || '-' != Dash)
+                        { Last = First; }
+                    for(Whole ID = First; ID <= Last; ++ID)
+                    {
+                        std::stringstream Dir;
+                        Dir << "/sys/devices/system/cpu/cpu" << ID;
+                        LogicalCPU Current;
+                        Current.ID = ID;
+                        Current.Core = ID;
+                        Current.Package = 0;
+                        Current.Node = 0;
+                        ReadSysfsWhole(Dir.str() + "/topology/core_id", Current.Core);
+                        ReadSysfsWhole(Dir.str() + "/topology/physical_package_id", Current.Package);
+                        ReadSysfsNode(Dir.str(), Current.Node);
+                        Results.push_back(Current);
+                    }
+                }
+            }
+        #endif
+        if(Results.empty())
+        {
+            Whole Count = GetCPUCount();
+            for(Whole ID = 0; ID < Count; ++ID)
+            {
+                LogicalCPU Current;
+                Current.ID = ID;
+                Current.Core = ID;
+                Current.Package = 0;
+                Current.Node = 0;
+                Results.push_back(Current);
+            }
+        }
+        return Results;
+    }
+
 }//Mezzanine
 
 #endif
@@ -46,9 +46,13 @@
 
 #include "datatypes.h"
 
+#include <vector>
+
 namespace Mezzanine
 {
     /// @brief Get a timestamp, in microseconds. This will generally be some multiple of the GetTimeStampResolution return value.
+    /// @details Where the platform has one this reads a monotonic clock, so the time between two timestamps is never thrown
+    /// off by the system time being set.
     /// @warning On some platforms this requires a static initialization, an can cause undefined behavior if called before static initializations are complete
     /// @return The largest size integer containing a timestamp that can be compared to other timestamps, but hads no guarantees for external value.
     MaxInt MEZZ_LIB GetTimeStamp();
@@ -83,6 +87,27 @@ namespace Mezzanine
     /// @warning There is a bug in MinGw which prevents this from working on windows. This always returns 64 in such situations.
     Whole MEZZ_LIB GetCachelineSize();
 
+    /// @brief Where one logical processor sits in the machine.
+    /// @details Logical processors that share a Core are hyperthreads/SMT siblings, and those that
+    /// share a Package share a socket and usually its last level of cache.
+    struct MEZZ_LIB LogicalCPU
+    {
+        /// @brief The ID the operating system uses for this logical processor, suitable for pinning threads to.
+        Whole ID;
+        /// @brief An ID for the physical core, only meaningful when compared to other cores in the same Package.
+        Whole Core;
+        /// @brief An ID for the physical processor package or socket.
+        Whole Package;
+        /// @brief The NUMA node whose memory is closest to this logical processor.
+        Whole Node;
+    };
+
+    /// @brief Get the logical processors that are online and how they are arranged into cores, packages and NUMA nodes.
+    /// @details On Linux this is read from /sys/devices/system/cpu. Where that is not available each
+    /// logical processor from 0 to GetCPUCount()-1 is assumed to be its own core on a single package and node.
+    /// @return A vector with one entry per online logical processor, sorted by ID.
+    std::vector<LogicalCPU> MEZZ_LIB GetCPUTopology();
+
 }//Mezzanine
 
 #endif
@@ -77,6 +77,10 @@ freely, subject to the following restrictions:
 #if defined(_MEZZ_THREAD_POSIX_)
     #include <map>
 #endif
+#ifdef __linux__
+    #include <cerrno>
+    #include <time.h>
+#endif
 
 
 namespace Mezzanine
@@ -319,6 +323,76 @@ namespace Mezzanine
             usleep(MicroSeconds);
         #endif
         }
+
+        void this_thread::sleep_until(MaxInt TimeStamp)
+        {
+        #if defined(__linux__) && !defined(_MEZZ_CPP11_) // GetTimeStamp reads CLOCK_MONOTONIC here
+            timespec Until;
+            Until.tv_sec = time_t(TimeStamp/1000000);
+            Until.tv_nsec = long(TimeStamp%1000000) * 1000;
+            while(EINTR==clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Until, NULL))
+                { } // A signal interrupted the sleep, the deadline has not moved
+        #else
+            MaxInt Now = GetTimeStamp();
+            if(Now<TimeStamp)
+                { sleep_for(UInt32(TimeStamp-Now)); }
+        #endif
+        }
+
+        bool this_thread::set_affinity(Whole CPU)
+        {
+        #if defined(_MEZZ_THREAD_WIN32_)
+            if(CPU >= sizeof(DWORD_PTR)*8)
+                { return false; }
+            return 0 != SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << CPU);
+        #elif defined(__linux__)
+            if(CPU >= CPU_SETSIZE)
+                { return false; }
+            cpu_set_t Set;
+            CPU_ZERO(&Set);
+            CPU_SET(CPU, &Set);
+            return 0 == pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set);
+        #else
+            (void)CPU;
+            return false;
+        #endif
+        }
+
+        #ifdef __linux__
+        /// @internal
+        /// @brief The logical processors the process could use when it started, recorded before anything is pinned.
+        struct StartingAffinity
+        {
+            /// @brief The mask of the thread that loaded this library, which is what new threads inherit.
+            cpu_set_t Set;
+            /// @brief False if the mask could not be read, then every logical processor is allowed instead.
+            bool Valid;
+            /// @brief Read the calling thread's mask.
+            StartingAffinity()
+                { Valid = 0 == sched_getaffinity(0, sizeof(Set), &Set); }
+        };
+        static StartingAffinity OriginalAffinity;
+        #endif
+
+        bool this_thread::clear_affinity()
+        {
+        #if defined(_MEZZ_THREAD_WIN32_)
+            DWORD_PTR ProcessMask, SystemMask;
+            if(!GetProcessAffinityMask(GetCurrentProcess(), &ProcessMask, &SystemMask))
+                { return false; }
+            return 0 != SetThreadAffinityMask(GetCurrentThread(), ProcessMask);
+        #elif defined(__linux__)
+            if(OriginalAffinity.Valid)
+                { return 0 == pthread_setaffinity_np(pthread_self(), sizeof(OriginalAffinity.Set), &OriginalAffinity.Set); }
+            cpu_set_t Set;
+            CPU_ZERO(&Set);
+            for(Whole Counter = 0; Counter < CPU_SETSIZE; ++Counter)
+                { CPU_SET(Counter, &Set); }
+            return 0 == pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set);
+        #else
+            return false;
+        #endif
+        }
     }//Threading
 }//Mezzanine
 
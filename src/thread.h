@@ -312,6 +312,26 @@ namespace Mezzanine
             /// @param MicroSeconds Minimum time to put the thread to sleep.
             void MEZZ_LIB sleep_for(UInt32 MicroSeconds);
 
+            /// @brief Blocks the calling thread until a point in time.
+            /// @details Unlike std::this_thread::sleep_until this takes a value from @ref GetTimeStamp. On Linux the
+            /// deadline is absolute, so time lost to being woken by signals or preempted before sleeping is not added
+            /// on. Elsewhere this sleeps for the difference. Either way the thread may wake somewhat late.
+            /// @param TimeStamp When to wake, does not block if this has passed.
+            void MEZZ_LIB sleep_until(MaxInt TimeStamp);
+
+            /// @brief Keep the calling thread on one logical processor.
+            /// @details Not part of std::this_thread. This is implemented on Linux and Windows, on
+            /// other platforms it does nothing and returns false.
+            /// @param CPU The operating system's ID for the logical processor, as in @ref GetCPUTopology.
+            /// @return True if the operating system accepted the request, false otherwise.
+            bool MEZZ_LIB set_affinity(Whole CPU);
+
+            /// @brief Let the calling thread run on any logical processor it could when the program started again.
+            /// @details On Linux this restores the mask the process started with, so limits set with taskset or a cgroup
+            /// are kept. On Windows it restores the process's affinity mask.
+            /// @return True if the operating system accepted the request, false otherwise.
+            bool MEZZ_LIB clear_affinity();
+
         } // namespace this_thread
     }//Threading
 }//Mezzanine
@@ -59,6 +59,25 @@ namespace Mezzanine
             Complete=3,     ///< Thread has completed all work this from frame, will not change until this frame ends.
             Failed=4        ///< Indicates an abnormal termination of a Workunit or other failure, Likely the whole application will need to stop.
         };//RunningState
+
+        /// @brief Which kind of @ref Barrier a @ref FrameScheduler synchronizes its threads with between frames, if it uses barriers.
+        enum BarrierAlgorithm
+        {
+            CentralBarrier=0,       ///< A @ref Barrier, every thread arrives at one shared count. Cheapest with few threads.
+            CombiningTreeBarrier=1  ///< A @ref TreeBarrier, threads arrive in small groups combined in a tree. Contends less with many threads.
+        };//BarrierAlgorithm
+
+        /// @brief How a @ref FrameScheduler assigns its threads to logical processors.
+        /// @details In each ordering the main thread gets the first logical processor, the first worker the second and so on,
+        /// wrapping around if there are more threads than logical processors.
+        enum ThreadAffinityPolicy
+        {
+            NoAffinity=0,                   ///< Threads are not pinned, the operating system moves them as it sees fit.
+            CompactAffinity=1,              ///< Threads fill each core, including hyperthreads, then each package before moving to the next. Shares the most cache.
+            ScatterAffinity=2,              ///< Threads alternate between packages and cores, hyperthreads are used last. Spreads threads across the most cache and memory bandwidth.
+            PhysicalCoresFirstAffinity=3,   ///< Threads fill one logical processor on each core of a package, then the next package, hyperthreads are used last.
+            ExplicitAffinity=4              ///< Threads use a list of logical processors passed to the FrameScheduler.
+        };//ThreadAffinityPolicy
     }//Threading
 }//Mezzanine
 #endif
@@ -0,0 +1,154 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _threadteam_cpp
+#define _threadteam_cpp
+
+#include "threadteam.h"
+#include "atomicoperations.h"
+
+/// @file
+/// @brief Contains the implementation for the @ref Mezzanine::Threading::ThreadTeam ThreadTeam.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        void ThreadTeam::RunRanges(void*, const Whole&, ThreadTeam& Team, DefaultThreadSpecificStorage::Type& CurrentThread)
+        {
+            Whole Grain = Team.RangeGrain;
+            for(Whole Begin = Whole(AtomicAdd(&Team.RangeNext,Int32(Grain))); Begin<Team.RangeEnd; Begin = Whole(AtomicAdd(&Team.RangeNext,Int32(Grain))))
+            {
+                Whole End = Begin+Grain<Team.RangeEnd ? Begin+Grain : Team.RangeEnd;
+                Team.RangeFunction(Team.RangeArgument, Begin, End, CurrentThread);
+            }
+        }
+
+        ThreadTeam::ThreadTeam()
+            : Sync(1),
+              Size(1),
+              Leader(0),
+              Command(0),
+              Argument(0),
+              NextMember(1),
+              RangeNext(0),
+              RangeEnd(0),
+              RangeGrain(1),
+              RangeFunction(0),
+              RangeArgument(0)
+        {}
+
+        Whole ThreadTeam::GetSize() const
+            { return Size; }
+
+        void ThreadTeam::Run(TeamFunction Function, void* Argument_)
+        {
+            if(!Leader)
+                { return; } // Only the thread running a Monopoly has a team
+            if(1==Size)
+            {
+                Function(Argument_, 0, *this, *Leader);
+                return;
+            }
+            Command = Function;
+            Argument = Argument_;
+            Sync.Wait(); // Members start
+            Function(Argument_, 0, *this, *Leader);
+            Sync.Wait(); // Members finish
+        }
+
+        void ThreadTeam::ParallelFor(const Whole& Begin, const Whole& End, TeamRangeFunction Function, void* Argument_, const Whole& Grain)
+        {
+            RangeNext = Int32(Begin);
+            RangeEnd = End;
+            RangeGrain = Grain ? Grain : 1;
+            RangeFunction = Function;
+            RangeArgument = Argument_;
+            Run(RunRanges, 0);
+        }
+
+        void ThreadTeam::Wait()
+        {
+            if(1<Size)
+                { Sync.Wait(); }
+        }
+
+        void ThreadTeam::SetSize(const Whole& ThreadCount)
+        {
+            Size = ThreadCount ? ThreadCount : 1;
+            Sync.SetThreadSyncCount(Int32(Size));
+        }
+
+        void ThreadTeam::Assemble(DefaultThreadSpecificStorage::Type& LeaderStorage)
+        {
+            Leader = &LeaderStorage;
+            if(1<Size)
+                { Sync.Wait(); } // Every member has finished what it was doing
+        }
+
+        void ThreadTeam::Serve(DefaultThreadSpecificStorage::Type& MemberStorage)
+        {
+            Whole Member = Whole(AtomicAdd(&NextMember,1));
+            Sync.Wait(); // Assembled
+            for(;;)
+            {
+                Sync.Wait(); // A command or dismissal was issued
+                TeamFunction Current = Command;
+                if(!Current)
+                    { return; }
+                Current(Argument, Member, *this, MemberStorage);
+                Sync.Wait();
+            }
+        }
+
+        void ThreadTeam::Dismiss()
+        {
+            if(1<Size)
+            {
+                Command = 0;
+                NextMember = 1; // No member joins again until released below
+                Sync.Wait();
+            }
+            Leader = 0;
+        }
+    }//Threading
+}//Mezzanine
+
+#endif
@@ -0,0 +1,177 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _threadteam_h
+#define _threadteam_h
+
+#include "datatypes.h"
+
+#if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
+#include "barrier.h"
+#include "doublebufferedresource.h"
+#endif
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::ThreadTeam ThreadTeam a running Monopoly uses the scheduler's threads through.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        class ThreadTeam;
+
+        /// @brief Work every thread in a @ref ThreadTeam runs at the same time.
+        /// @param Argument Whatever was passed to @ref ThreadTeam::Run along with this function.
+        /// @param Member A number from 0 to one less than the size of the team that no other thread in the team gets, 0 is
+        /// the thread running the Monopoly.
+        /// @param Team The team running this, so members can call @ref ThreadTeam::Wait.
+        /// @param CurrentThread The resources of the thread running this.
+        typedef void (*TeamFunction)(void* Argument, const Whole& Member, ThreadTeam& Team, DefaultThreadSpecificStorage::Type& CurrentThread);
+
+        /// @brief Work on part of a range passed to @ref ThreadTeam::ParallelFor.
+        /// @param Argument Whatever was passed to ParallelFor along with this function.
+        /// @param Begin The first index to work on.
+        /// @param End One past the last index to work on.
+        /// @param CurrentThread The resources of the thread running this.
+        typedef void (*TeamRangeFunction)(void* Argument, const Whole& Begin, const Whole& End, DefaultThreadSpecificStorage::Type& CurrentThread);
+
+        /// @brief The threads of a @ref FrameScheduler lent to a running @ref MonopolyWorkUnit.
+        /// @details While a Monopoly runs no other WorkUnit does, so every other thread the scheduler is running this frame
+        /// waits in its team instead of sitting idle. The Monopoly gets this from
+        /// @ref FrameScheduler::GetThreadTeam "GetThreadTeam()" and uses @ref Run or @ref ParallelFor to put those threads to
+        /// work. Between frames, or when the scheduler uses one thread, the team is just the calling thread.
+        /// @warning Only the thread running the Monopoly may call @ref Run or @ref ParallelFor.
+        class MEZZ_LIB ThreadTeam
+        {
+            protected:
+                /// @brief Every member waits here to start and finish each command.
+                Barrier Sync;
+
+                /// @brief How many threads are in the team, including the one running the Monopoly.
+                Whole Size;
+
+                /// @brief The resources of the thread running the Monopoly, while it is running.
+                DefaultThreadSpecificStorage::Type* Leader;
+
+                /// @brief What each member should run next, or null to leave the team.
+                TeamFunction Command;
+
+                /// @brief Passed to Command.
+                void* Argument;
+
+                /// @brief The member number the next thread to join gets.
+                Int32 NextMember;
+
+                /// @brief The next index of the current ParallelFor no member has claimed.
+                Int32 RangeNext;
+
+                /// @brief One past the last index of the current ParallelFor.
+                Whole RangeEnd;
+
+                /// @brief How many indexes a member claims at once in the current ParallelFor.
+                Whole RangeGrain;
+
+                /// @brief The function of the current ParallelFor.
+                TeamRangeFunction RangeFunction;
+
+                /// @brief The argument of the current ParallelFor.
+                void* RangeArgument;
+
+                /// @brief Each member claims and runs parts of a ParallelFor until none are left.
+                /// @param Argument Ignored.
+                /// @param Member Ignored.
+                /// @param Team The team running the ParallelFor.
+                /// @param CurrentThread Passed to the range function.
+                static void RunRanges(void* Argument, const Whole& Member, ThreadTeam& Team, DefaultThreadSpecificStorage::Type& CurrentThread);
+
+            private:
+                /// @brief Deny Copy construction, threads wait on a specific instance.
+                ThreadTeam(const ThreadTeam&);
+
+                /// @brief Deny Assignment, threads wait on a specific instance.
+                void operator=(const ThreadTeam&);
+
+            public:
+                /// @brief Constructor, creates a team of one thread.
+                ThreadTeam();
+
+                /// @brief How many threads are in this team?
+                /// @return A Whole, 1 when only the thread running the Monopoly is available.
+                Whole GetSize() const;
+
+                /// @brief Have every member of the team run a function at the same time.
+                /// @param Function The work to do.
+                /// @param Argument Passed to Function.
+                /// @details Returns once every member has returned from Function. Members may use @ref Wait to synchronize
+                /// with each other part way through. This does nothing if no Monopoly is running with this team.
+                void Run(TeamFunction Function, void* Argument);
+
+                /// @brief Split a range of indexes between the members of the team.
+                /// @param Begin The first index.
+                /// @param End One past the last index.
+                /// @param Function Called with each part of the range, in no particular order.
+                /// @param Argument Passed to Function.
+                /// @param Grain The most indexes passed to Function at once, members claim parts of this size until the range
+                /// is used up, so uneven work balances itself.
+                void ParallelFor(const Whole& Begin, const Whole& End, TeamRangeFunction Function, void* Argument, const Whole& Grain = 1);
+
+                /// @brief Wait until every member of the team reaches this point.
+                /// @details Only call this from a function passed to @ref Run, and have every member call it the same number of times.
+                void Wait();
+
+                /// @brief Set how many threads the scheduler lends to Monopolies.
+                /// @param ThreadCount The count including the thread running the Monopoly.
+                /// @warning Only the FrameScheduler should call this, while no Monopoly is running.
+                void SetSize(const Whole& ThreadCount);
+
+                /// @brief Called on the thread running a Monopoly, returns once every other member has joined.
+                /// @param LeaderStorage The resources of the calling thread.
+                void Assemble(DefaultThreadSpecificStorage::Type& LeaderStorage);
+
+                /// @brief Called by each of the scheduler's other threads to join the team until it is dismissed.
+                /// @param MemberStorage The resources of the calling thread.
+                void Serve(DefaultThreadSpecificStorage::Type& MemberStorage);
+
+                /// @brief Called on the thread running a Monopoly when it is done, lets every other member leave.
+                void Dismiss();
+        };//ThreadTeam
+    }//Threading
+}//Mezzanine
+#endif
@@ -0,0 +1,234 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _timerwheel_cpp
+#define _timerwheel_cpp
+
+#include "timerwheel.h"
+
+#include <limits>
+
+/// @file
+/// @brief The implementation of the @ref Mezzanine::Threading::TimerWheel a FrameScheduler keeps its timers in.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        const Whole TimerWheel::LevelCount;
+        const Whole TimerWheel::LevelBits;
+        const Whole TimerWheel::LevelSize;
+
+        void TimerWheel::Link(Int32 Index)
+        {
+            Timer& Linking = Timers[Index];
+            MaxInt Delta = Linking.Expiry - CurrentTick;
+            MaxInt Tick = Linking.Expiry;
+            Whole Level = 0;
+            if(0>=Delta)
+            {
+                Tick = CurrentTick; // Only while advancing, the first level's bucket for this tick is expired after cascading
+            }else{
+                while(Level+1<LevelCount && Delta>=(MaxInt(1)<<(LevelBits*(Level+1))))
+                    { ++Level; }
+                MaxInt Span = MaxInt(1)<<(LevelBits*LevelCount);
+                if(Delta>=Span)
+                    { Tick = CurrentTick+Span-1; } // Past the end of the wheel, it waits in the farthest bucket and is linked again from there
+            }
+
+            Int32 Bucket = Int32(Level*LevelSize + Whole((Tick>>(LevelBits*Level)) & (LevelSize-1)));
+            Linking.Bucket = Bucket;
+            Linking.Previous = -1;
+            Linking.Next = Buckets[Bucket];
+            if(-1!=Linking.Next)
+                { Timers[Linking.Next].Previous = Index; }
+            Buckets[Bucket] = Index;
+        }
+
+        void TimerWheel::Unlink(Int32 Index)
+        {
+            Timer& Unlinking = Timers[Index];
+            if(-1==Unlinking.Previous)
+                { Buckets[Unlinking.Bucket] = Unlinking.Next; }
+            else
+                { Timers[Unlinking.Previous].Next = Unlinking.Next; }
+            if(-1!=Unlinking.Next)
+                { Timers[Unlinking.Next].Previous = Unlinking.Previous; }
+        }
+
+        void TimerWheel::Free(Int32 Index)
+        {
+            Timer& Freeing = Timers[Index];
+            Freeing.Bucket = -1;
+            Freeing.Function = 0;
+            Freeing.Argument = 0;
+            Freeing.Generation = (Freeing.Generation+1) & 0x7fffffff; // Kept positive so handles are too
+            if(0==Freeing.Generation)
+                { Freeing.Generation = 1; }
+            Freeing.Next = FirstFree;
+            FirstFree = Index;
+        }
+
+        Int32 TimerWheel::Find(TimerHandle Handle) const
+        {
+            MaxInt Index = Handle & 0xffffffff;
+            if(0>Handle || Index>=MaxInt(Timers.size()))
+                { return -1; }
+            const Timer& Found = Timers[Index];
+            if(-1==Found.Bucket || MaxInt(Found.Generation)!=(Handle>>32))
+                { return -1; }
+            return Int32(Index);
+        }
+
+        TimerWheel::TimerWheel(const MaxInt& Now) :
+            Buckets(LevelCount*LevelSize,-1),
+            FirstFree(-1),
+            Count(0),
+            CurrentTick(Now/MEZZ_TIMERRESOLUTION)
+            {}
+
+        TimerHandle TimerWheel::Add(ForkedFunction Function, void* Argument, const MaxInt& ExpiryTime, const MaxInt& Period)
+        {
+            Int32 Index = FirstFree;
+            if(-1==Index)
+            {
+                Timers.push_back(Timer());
+                Index = Int32(Timers.size()-1);
+                Timers[Index].Generation = 1;
+            }else{
+                FirstFree = Timers[Index].Next;
+            }
+
+            Timer& Adding = Timers[Index];
+            Adding.Expiry = (ExpiryTime+MEZZ_TIMERRESOLUTION-1)/MEZZ_TIMERRESOLUTION; // Rounded up so it is never early
+            if(Adding.Expiry<=CurrentTick)
+                { Adding.Expiry = CurrentTick+1; } // Already due, this tick's bucket has been expired
+            Adding.Period = 0<Period ? (Period+MEZZ_TIMERRESOLUTION-1)/MEZZ_TIMERRESOLUTION : 0;
+            Adding.Function = Function;
+            Adding.Argument = Argument;
+            Link(Index);
+            ++Count;
+            return (MaxInt(Adding.Generation)<<32) | MaxInt(Index);
+        }
+
+        bool TimerWheel::Cancel(TimerHandle Handle)
+        {
+            Int32 Index = Find(Handle);
+            if(-1==Index)
+                { return false; }
+            Unlink(Index);
+            Free(Index);
+            --Count;
+            return true;
+        }
+
+        bool TimerWheel::IsWaiting(TimerHandle Handle) const
+            { return -1!=Find(Handle); }
+
+        Whole TimerWheel::GetCount() const
+            { return Count; }
+
+        MaxInt TimerWheel::GetNextCheckTime() const
+        {
+            if(!Count)
+                { return std::numeric_limits<MaxInt>::max(); }
+            MaxInt Tick = CurrentTick+1;
+            while(-1==Buckets[Whole(Tick & (LevelSize-1))] && 0!=(Tick & (LevelSize-1)))
+                { ++Tick; } // Stops where the first level wraps, timers from the level above may be spread out there
+            return Tick*MEZZ_TIMERRESOLUTION;
+        }
+
+        void TimerWheel::Advance(const MaxInt& Now, std::vector<ExpiredTimer>& Expired)
+        {
+            MaxInt NowTick = Now/MEZZ_TIMERRESOLUTION;
+            while(CurrentTick<NowTick)
+            {
+                if(!Count)
+                {
+                    CurrentTick = NowTick; // Nothing to expire in between
+                    break;
+                }
+                ++CurrentTick;
+
+                Whole Top = 0; // The highest level wrapping at this tick
+                while(Top+1<LevelCount && 0==(CurrentTick & ((MaxInt(1)<<(LevelBits*(Top+1)))-1)))
+                    { ++Top; }
+                for(Whole Level = Top; 0<Level; --Level)
+                {
+                    Int32 Bucket = Int32(Level*LevelSize + Whole((CurrentTick>>(LevelBits*Level)) & (LevelSize-1)));
+                    Int32 Index = Buckets[Bucket];
+                    Buckets[Bucket] = -1;
+                    while(-1!=Index)
+                    {
+                        Int32 Next = Timers[Index].Next;
+                        Link(Index); // Closer now, so it lands in a lower level
+                        Index = Next;
+                    }
+                }
+
+                Int32 Bucket = Int32(CurrentTick & (LevelSize-1));
+                Int32 Index = Buckets[Bucket];
+                Buckets[Bucket] = -1;
+                while(-1!=Index)
+                {
+                    Timer& Expiring = Timers[Index];
+                    Int32 Next = Expiring.Next;
+                    ExpiredTimer Result;
+                    Result.Function = Expiring.Function;
+                    Result.Argument = Expiring.Argument;
+                    Expired.push_back(Result);
+                    if(Expiring.Period)
+                    {
+                        Expiring.Expiry += Expiring.Period;
+                        if(Expiring.Expiry<=NowTick)
+                            { Expiring.Expiry += ((NowTick-Expiring.Expiry)/Expiring.Period+1)*Expiring.Period; } // Skip the expiries it missed
+                        Link(Index);
+                    }else{
+                        Free(Index);
+                        --Count;
+                    }
+                    Index = Next;
+                }
+            }
+        }
+    }//Threading
+}//Mezzanine
+
+#endif
@@ -0,0 +1,190 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _timerwheel_h
+#define _timerwheel_h
+
+#include "datatypes.h"
+
+#if !defined(SWIG) || defined(SWIG_THREADING) // Do not read when in swig and not in the threading module
+#include "forkjoingroup.h"
+#endif
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::TimerWheel a FrameScheduler keeps its timers in.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        /// @brief Identifies a timer in a @ref TimerWheel, it stays valid until the timer expires for the last time or is cancelled.
+        /// @details 0 is never a valid timer.
+        typedef MaxInt TimerHandle;
+
+        /// @brief A hierarchical timer wheel that stores many timers and finds the expired ones without checking each one.
+        /// @details Time is divided into ticks of @ref MEZZ_TIMERRESOLUTION microseconds. The first level of the wheel has a
+        /// bucket for each of the next 64 ticks, the next level has a bucket for each of the next 64 spans of 64 ticks and so
+        /// on. Adding a timer links it into the one bucket covering when it expires, and cancelling unlinks it, so both take
+        /// the same time no matter how many timers there are. Advancing the wheel only looks at the buckets for the ticks
+        /// passed, and each time the first level wraps the timers in the next bucket of the level above are spread over it.
+        /// @n @n
+        /// Timers expire on the first tick that starts at or after the time asked for, never early. The timers are kept in one
+        /// array and reused, so adding and cancelling them does not allocate once the array has grown.
+        /// @n @n
+        /// This is not thread safe, the @ref FrameScheduler guards its TimerWheel with a lock.
+        class MEZZ_LIB TimerWheel
+        {
+            public:
+                /// @brief A timer that expired, as returned by @ref Advance.
+                struct ExpiredTimer
+                {
+                    /// @brief The work to do.
+                    ForkedFunction Function;
+                    /// @brief Passed to Function.
+                    void* Argument;
+                };
+
+                /// @brief How many levels of buckets there are.
+                static const Whole LevelCount = 4;
+
+                /// @brief How many bits of the tick each level sorts by.
+                static const Whole LevelBits = 6;
+
+                /// @brief How many buckets each level has.
+                static const Whole LevelSize = 1<<LevelBits;
+
+            protected:
+                /// @brief One timer, linked into a bucket while it is waiting and into the free list otherwise.
+                struct Timer
+                {
+                    /// @brief The tick this expires at.
+                    MaxInt Expiry;
+                    /// @brief How many ticks until it expires again, 0 if it only expires once.
+                    MaxInt Period;
+                    /// @brief The work to do.
+                    ForkedFunction Function;
+                    /// @brief Passed to Function.
+                    void* Argument;
+                    /// @brief The next timer in the same bucket or free list, -1 if none.
+                    Int32 Next;
+                    /// @brief The previous timer in the same bucket, -1 if first.
+                    Int32 Previous;
+                    /// @brief The bucket this is linked into, -1 if it is free.
+                    Int32 Bucket;
+                    /// @brief Raised each time this is freed, so handles to earlier uses of it can be recognized.
+                    Whole Generation;
+                };
+
+                /// @brief Every timer ever needed, waiting or free.
+                std::vector<Timer> Timers;
+
+                /// @brief The first timer in each bucket, -1 if the bucket is empty. Each level's buckets follow the level below.
+                std::vector<Int32> Buckets;
+
+                /// @brief The first free timer, -1 if all are in use.
+                Int32 FirstFree;
+
+                /// @brief How many timers are waiting.
+                Whole Count;
+
+                /// @brief The last tick timers have been expired for.
+                MaxInt CurrentTick;
+
+                /// @brief Link a timer into the bucket covering its expiry.
+                /// @param Index Which timer.
+                void Link(Int32 Index);
+
+                /// @brief Remove a timer from its bucket.
+                /// @param Index Which timer.
+                void Unlink(Int32 Index);
+
+                /// @brief Put a timer on the free list so it can be reused.
+                /// @param Index Which timer.
+                void Free(Int32 Index);
+
+                /// @brief Find the timer a handle refers to.
+                /// @param Handle A handle returned by @ref Add.
+                /// @return The index of the timer or -1 if the handle is not for a waiting timer.
+                Int32 Find(TimerHandle Handle) const;
+
+            public:
+                /// @brief Constructor, creates an empty wheel.
+                /// @param Now The current time in microseconds, usually from @ref Mezzanine::GetTimeStamp "GetTimeStamp()".
+                explicit TimerWheel(const MaxInt& Now);
+
+                /// @brief Add a timer.
+                /// @param Function The work to do when it expires.
+                /// @param Argument Passed to Function, this must stay valid until the timer is cancelled or expires for the last time.
+                /// @param ExpiryTime When it should first expire in microseconds, on the same clock passed to @ref Advance.
+                /// @param Period If not 0, the timer expires again this many microseconds after each expiry until it is
+                /// cancelled. This is rounded up to a whole tick.
+                /// @return A handle to pass to @ref Cancel.
+                TimerHandle Add(ForkedFunction Function, void* Argument, const MaxInt& ExpiryTime, const MaxInt& Period = 0);
+
+                /// @brief Stop a timer from expiring again.
+                /// @param Handle A handle returned by @ref Add.
+                /// @return True if the timer was waiting and is now cancelled, false if it had already expired for the last time
+                /// or been cancelled.
+                bool Cancel(TimerHandle Handle);
+
+                /// @brief Is a timer waiting to expire?
+                /// @param Handle A handle returned by @ref Add.
+                /// @return False once it has expired for the last time or been cancelled.
+                bool IsWaiting(TimerHandle Handle) const;
+
+                /// @brief How many timers are waiting?
+                /// @return A Whole including periodic timers, until they are cancelled.
+                Whole GetCount() const;
+
+                /// @brief When should @ref Advance next be called?
+                /// @return The start of the next tick with a timer expiring, or earlier if finding that would mean looking past
+                /// the first level. The largest MaxInt if no timers are waiting.
+                MaxInt GetNextCheckTime() const;
+
+                /// @brief Find every timer that expired since the last call, and reschedule the periodic ones.
+                /// @param Now The current time in microseconds.
+                /// @param Expired Each expired timer is appended to this. A periodic timer that missed several expiries is only
+                /// appended once.
+                void Advance(const MaxInt& Now, std::vector<ExpiredTimer>& Expired);
+        };//TimerWheel
+    }//Threading
+}//Mezzanine
+
+#endif
@@ -0,0 +1,162 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _treebarrier_cpp
+#define _treebarrier_cpp
+
+#include "treebarrier.h"
+
+#include <cassert>
+#include <cstddef>
+
+/// @file
+/// @brief Contains the implementation for the @ref Mezzanine::Threading::TreeBarrier TreeBarrier synchronization object.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        const Int32 TreeBarrier::FanIn;
+
+        void TreeBarrier::BuildTree()
+        {
+            if(1>=ThreadGoal)
+                { return; } // The old tree is kept, threads may still be leaving it
+
+            Int32 NodeCount = 0;
+            for(Int32 Arrivals = ThreadGoal; 1<Arrivals; Arrivals = (Arrivals+FanIn-1)/FanIn)
+                { NodeCount += (Arrivals+FanIn-1)/FanIn; }
+
+            if(NodeCapacity<NodeCount)
+            {
+                // Threads released from the last use could still be reading the current nodes, so they are only deleted
+                // once a later use has replaced them too
+                delete[] RetiredStorage;
+                RetiredStorage = NodeStorage;
+                NodeStorage = new char[NodeCount*sizeof(Node)+sizeof(Node)];
+                NodeCapacity = NodeCount;
+                size_t Misalignment = size_t(NodeStorage) % sizeof(Node);
+                Nodes = (Node*)(NodeStorage + (Misalignment ? sizeof(Node)-Misalignment : 0));
+            }
+
+            Int32 LevelStart = 0;
+            for(Int32 Arrivals = ThreadGoal; 1<Arrivals; Arrivals = (Arrivals+FanIn-1)/FanIn)
+            {
+                Int32 LevelCount = (Arrivals+FanIn-1)/FanIn;
+                for(Int32 Current = 0; Current<LevelCount; ++Current)
+                {
+                    Node& Filling = Nodes[LevelStart+Current];
+                    Filling.Arrived = 0;
+                    Filling.Goal = (Current+1)*FanIn<=Arrivals ? FanIn : Arrivals-Current*FanIn;
+                    Filling.Parent = 1<LevelCount ? LevelStart+LevelCount+Current/FanIn : -1;
+                }
+                LevelStart += LevelCount;
+            }
+        }
+
+        TreeBarrier::TreeBarrier (const Int32& SynchThreadCount, const Whole& SpinLimit_)
+            : Barrier(SynchThreadCount, SpinLimit_),
+              NodeStorage(0),
+              RetiredStorage(0),
+              Nodes(0),
+              NodeCapacity(0),
+              Tickets(0)
+            { BuildTree(); }
+
+        TreeBarrier::~TreeBarrier()
+        {
+            delete[] NodeStorage;
+            delete[] RetiredStorage;
+        }
+
+        bool TreeBarrier::Wait()
+        {
+            Int32 Goal = AtomicLoad(&ThreadGoal);
+            if(1>=Goal)
+                { return Barrier::Wait(); }
+            return Wait(AtomicAdd(&Tickets,1)%Goal);
+        }
+
+        bool TreeBarrier::Wait(const Int32& ThreadIndex)
+        {
+            Int32 ThreadCount = AtomicLoad(&ThreadGoal);
+            if(1>=ThreadCount)
+                { return Barrier::Wait(); } // Nothing to combine with 1 or fewer threads
+            assert(0<=ThreadIndex && ThreadIndex<ThreadCount); // Each thread needs its own index below the thread count
+            Int32 Index = Int32(Whole(ThreadIndex)%Whole(ThreadCount)); // Stay in the tree even if misused
+
+            Node* Tree = Nodes;
+            Int32 Sense = AtomicLoad(&Generation);
+            for(Int32 Current = Index/FanIn; ; )
+            {
+                Node& Arriving = Tree[Current];
+                // Once this arrives, the last thread at the root can release every thread and the tree could be laid out
+                // again, so nothing is read from the node after that except by the thread that completed it
+                Int32 Goal = Arriving.Goal;
+                Int32 Parent = Arriving.Parent;
+                if(AtomicAdd(&Arriving.Arrived,1)+1<Goal)
+                {
+                    WaitForRelease(Sense);
+                    return false;
+                }
+                AtomicCompareAndSwap32(&Arriving.Arrived,Goal,0); // Nothing arrives here again until released
+                if(0>Parent)
+                    { break; }
+                Current = Parent;
+            }
+            AtomicCompareAndSwap32(&Tickets,Tickets,0);
+            Release();
+            return true;
+        }
+
+        void TreeBarrier::SetThreadSyncCount(Int32 NewCount)
+        {
+            if(NewCount==AtomicAdd(&ThreadGoal,0))
+                { return; }
+            Barrier::SetThreadSyncCount(NewCount);
+            if(0>=NewCount)
+                { Release(); } // Threads could still be leaving the tree, so it is kept until it is laid out again
+            else
+                { BuildTree(); }
+        }
+
+    } // \Threading namespace
+} // \Mezzanine namespace
+#endif
@@ -0,0 +1,129 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _treebarrier_h
+#define _treebarrier_h
+
+#include "datatypes.h"
+#include "barrier.h"
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::TreeBarrier TreeBarrier synchronization primitive
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        /// @brief A @ref Barrier that counts arriving threads in a tree of small groups instead of in one place.
+        /// @details With a plain Barrier every thread arriving changes the same count, so the cost of each use grows with the
+        /// amount of threads as they contend for one cache line. This is a combining tree, threads arrive in groups of
+        /// @ref FanIn at leaves of the tree and the last of each group carries the arrival up to the next level. Only the thread
+        /// completing the root trips the barrier. Each node of the tree is on its own cache line.
+        /// @n @n
+        /// Threads should pass a distinct index to @ref Wait(const Int32&). Calling @ref Wait() without one hands out indexes
+        /// from a single shared count, which works but brings back some of the contention this avoids. Do not mix the two in one
+        /// use of the barrier.
+        class MEZZ_LIB TreeBarrier : public Barrier
+        {
+            public:
+                /// @brief How many threads or nodes of the tree arrive at each node.
+                static const Int32 FanIn = 4;
+
+            protected:
+                /// @brief One group of arrivals in the tree, padded to fill a cache line.
+                struct Node
+                {
+                    /// @brief How many threads or child nodes have arrived at this node in this use of the barrier.
+                    Int32 Arrived;
+                    /// @brief How many threads or child nodes arrive at this node each use of the barrier.
+                    Int32 Goal;
+                    /// @brief The index of the node the last arrival here carries on to, or -1 for the root.
+                    Int32 Parent;
+                    /// @brief Keeps other nodes off of this cache line.
+                    char Padding[64-3*sizeof(Int32)];
+                };
+
+                /// @brief Memory allocated for the nodes, with room to align them to a cache line.
+                char* NodeStorage;
+
+                /// @brief The storage NodeStorage replaced when the tree last grew, kept for threads still leaving it.
+                char* RetiredStorage;
+
+                /// @brief The nodes of the tree, leaves first and the root last.
+                Node* Nodes;
+
+                /// @brief How many nodes fit in NodeStorage, it only grows so a smaller tree reuses it.
+                Int32 NodeCapacity;
+
+                /// @brief Used to give indexes to threads calling @ref Wait() without one.
+                Int32 Tickets;
+
+                /// @brief Lay out the tree for the current thread count.
+                /// @details Storage is only replaced when the tree needs more nodes than it holds, and the replaced storage
+                /// is kept until it is replaced again.
+                void BuildTree();
+
+            public:
+                /// @brief Constructor
+                /// @param SynchThreadCount The amount of threads that this should wait for. If 0 is passed all threads waiting advance.
+                /// @param SpinLimit_ How many times a waiting thread checks the barrier before sleeping.
+                TreeBarrier (const Int32& SynchThreadCount, const Whole& SpinLimit_ = 1024);
+
+                /// @brief Destructor, deletes the tree.
+                virtual ~TreeBarrier();
+
+                /// @copydoc Barrier::Wait()
+                virtual bool Wait ();
+
+                /// @brief Wait until the specified number of threads reach this point, arriving at the leaf for this thread.
+                /// @param ThreadIndex A number from 0 to one less than the thread count, that no other thread uses when waiting on this.
+                /// @return The last thread to reach this point gets true, the others are returned false.
+                virtual bool Wait (const Int32& ThreadIndex);
+
+                /// @brief Set the Thread count and lay out the tree again.
+                /// @param NewCount The new amount threads to sync.
+                /// @warning Unless the count is unchanged or 0, this must not be called while any thread waits on this.
+                /// Setting this to 0 releases every waiting thread.
+                virtual void SetThreadSyncCount(Int32 NewCount);
+
+        };//TreeBarrier
+    }//Threading
+}//Mezzanine
+#endif
@@ -0,0 +1,145 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _workstealingdeque_cpp
+#define _workstealingdeque_cpp
+
+#include "workstealingdeque.h"
+#include "atomicoperations.h"
+
+/// @file
+/// @brief The implementation of the @ref Mezzanine::Threading::WorkStealingDeque that each thread keeps its ready work in.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        const Int32 WorkStealingDeque::Empty;
+
+        WorkStealingDeque::WorkStealingDeque(const WorkStealingDeque&)
+            {}
+
+        WorkStealingDeque& WorkStealingDeque::operator=(const WorkStealingDeque&)
+            { return *this; }
+
+        WorkStealingDeque::WorkStealingDeque() :
+            Entries(1,Empty),
+            Mask(0),
+            Top(0),
+            Bottom(0),
+            Active(false),
+            NextVictim(0)
+            {}
+
+        void WorkStealingDeque::Reset(const Whole& MinimumCapacity)
+        {
+            Whole Capacity = Entries.size();
+            while(Capacity<MinimumCapacity)
+                { Capacity*=2; }
+            if(Capacity!=Entries.size())
+                { Entries.resize(Capacity,Empty); }
+            Mask = Int32(Capacity-1);
+            Top = 0;
+            Bottom = 0;
+            Active = true;
+        }
+
+        void WorkStealingDeque::Deactivate()
+            { Active = false; }
+
+        void WorkStealingDeque::Relocate()
+            { std::vector<Int32>(Entries).swap(Entries); }
+
+        bool WorkStealingDeque::IsActive() const
+            { return Active; }
+
+        void WorkStealingDeque::Push(const Int32& Entry)
+        {
+            Entries[Bottom & Mask] = Entry;
+            AtomicAdd(&Bottom,1); // The full barrier publishes the entry before thieves can see the new Bottom
+        }
+
+        Int32 WorkStealingDeque::Pop()
+        {
+            Int32 NewBottom = AtomicAdd(&Bottom,-1) - 1; // Claim the bottom entry before looking at Top
+            Int32 OldTop = Top;
+            if(OldTop>NewBottom)
+            {
+                AtomicAdd(&Bottom,1); // It was already empty
+                return Empty;
+            }
+
+            Int32 Results = Entries[NewBottom & Mask];
+            if(OldTop==NewBottom) // Last entry, thieves could be racing for it
+            {
+                if(OldTop!=AtomicCompareAndSwap32(&Top,OldTop,OldTop+1))
+                    { Results = Empty; }
+                AtomicAdd(&Bottom,1);
+            }
+            return Results;
+        }
+
+        Int32 WorkStealingDeque::Steal()
+        {
+            Int32 OldTop = AtomicAdd(&Top,0);
+            Int32 CurrentBottom = AtomicAdd(&Bottom,0);
+            if(OldTop>=CurrentBottom)
+                { return Empty; }
+
+            Int32 Results = Entries[OldTop & Mask];
+            if(OldTop!=AtomicCompareAndSwap32(&Top,OldTop,OldTop+1))
+                { return Empty; } // Lost the race to the owner or another thief
+            return Results;
+        }
+
+        Whole WorkStealingDeque::GetSize() const
+        {
+            Int32 Results = Bottom - Top;
+            return Results>0 ? Whole(Results) : 0;
+        }
+
+        Whole WorkStealingDeque::GetNextVictim() const
+            { return NextVictim; }
+
+        void WorkStealingDeque::SetNextVictim(const Whole& Victim)
+            { NextVictim = Victim; }
+    }//Threading
+}//Mezzanine
+#endif
@@ -0,0 +1,144 @@
+// The DAGFrameScheduler is a Multi-Threaded lock free and wait free scheduling library.
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The DAGFrameScheduler.
+
+    The DAGFrameScheduler is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The DAGFrameScheduler is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The DAGFrameScheduler.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'doc' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the DAGFrameScheduler to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _workstealingdeque_h
+#define _workstealingdeque_h
+
+#include "datatypes.h"
+
+/// @file
+/// @brief The declaration of the @ref Mezzanine::Threading::WorkStealingDeque that each thread keeps its ready work in.
+
+namespace Mezzanine
+{
+    namespace Threading
+    {
+        /// @brief A Chase-Lev style double ended queue that one thread pushes and pops from and any thread can steal from.
+        /// @details The owning thread pushes and pops at the bottom, so it is always working on the work it most recently
+        /// made ready, which is the most likely to still be in its cache. Other threads steal from the top. Only a steal
+        /// that races for the last entry needs an @ref AtomicCompareAndSwap32 "Atomic Compare and Swap", so threads
+        /// mostly work on their own cache lines.
+        /// @n @n
+        /// Entries are the readiness slots the @ref FrameScheduler uses to identify WorkUnits. The storage is a ring
+        /// buffer sized with @ref Reset, it never grows during a frame. This works because each WorkUnit is pushed at
+        /// most once a frame, so there can never be more entries than WorkUnits.
+        class MEZZ_LIB WorkStealingDeque
+        {
+            protected:
+                /// @brief The ring buffer of entries, its size is always a power of 2.
+                std::vector<Int32> Entries;
+
+                /// @brief One less than the size of Entries, used to wrap indexes into the ring buffer.
+                Int32 Mask;
+
+                /// @brief The index of the oldest entry, only increases and thieves take from here.
+                Int32 Top;
+
+                /// @brief One past the index of the newest entry, only the owning thread changes this.
+                Int32 Bottom;
+
+                /// @brief Is this participating in the current frame.
+                bool Active;
+
+                /// @brief Where the owning thread should start looking next time it needs to steal.
+                Whole NextVictim;
+
+            private:
+                /// @brief Copying a deque that other threads could be stealing from makes no sense, made private.
+                WorkStealingDeque(const WorkStealingDeque&);
+
+                /// @brief Assigning a deque that other threads could be stealing from makes no sense, made private.
+                WorkStealingDeque& operator=(const WorkStealingDeque&);
+
+            public:
+                /// @brief The value returned by @ref Pop and @ref Steal when no entry could be taken.
+                static const Int32 Empty = -1;
+
+                /// @brief Constructor, creates an empty and inactive deque.
+                WorkStealingDeque();
+
+                /// @brief Empty this, make sure it can hold a given amount of entries and mark it active.
+                /// @param MinimumCapacity The most entries that could be pushed before the next reset.
+                /// @warning This must only be called when no other thread is using this deque.
+                void Reset(const Whole& MinimumCapacity);
+
+                /// @brief Mark this as not participating in frames until the next @ref Reset.
+                void Deactivate();
+
+                /// @brief Move the ring buffer into memory allocated and first touched by the calling thread.
+                /// @details On NUMA systems the operating system usually places memory on the node of the thread that first
+                /// writes to it, so the owning thread calls this to keep its deque in memory close to it.
+                /// @warning This must only be called when no other thread is using this deque, such as while it is not active.
+                void Relocate();
+
+                /// @brief Is this deque being used in the current frame.
+                /// @return True between a call to @ref Reset and a call to @ref Deactivate, false otherwise.
+                bool IsActive() const;
+
+                /// @brief Add an entry to the bottom.
+                /// @param Entry A non-negative value to store.
+                /// @warning Only the owning thread may call this.
+                void Push(const Int32& Entry);
+
+                /// @brief Remove the newest entry from the bottom.
+                /// @return The newest entry or @ref Empty if there are none left.
+                /// @warning Only the owning thread may call this.
+                Int32 Pop();
+
+                /// @brief Remove the oldest entry from the top.
+                /// @return The oldest entry, or @ref Empty if there were none or another thread took it first.
+                /// @details This is safe to call from any thread at any time.
+                Int32 Steal();
+
+                /// @brief Get a rough count of the entries, this is stale as soon as it is returned if other threads are working.
+                /// @return A Whole with the count.
+                Whole GetSize() const;
+
+                /// @brief Where should the owning thread start looking for a victim when it steals.
+                /// @return The index the owner last stole from successfully.
+                Whole GetNextVictim() const;
+
+                /// @brief Set where the owning thread should start looking for a victim when it steals.
+                /// @param Victim The index of the thread to try first next time.
+                void SetNextVictim(const Whole& Victim);
+        };//WorkStealingDeque
+    }//Threading
+}//Mezzanine
+#endif
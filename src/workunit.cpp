@@ -66,7 +66,21 @@ namespace Mezzanine
         DefaultWorkUnit& DefaultWorkUnit::operator=(DefaultWorkUnit& Unused)
             { return Unused; }
 
-        DefaultWorkUnit::DefaultWorkUnit() : CurrentRunningState(NotStarted)
+        Int32 DefaultWorkUnit::TagRunningState(RunningState State) const
+        {
+            UInt32 Epoch = FrameEpoch ? *FrameEpoch : 0;
+            return Int32((Epoch<<3) | UInt32(State));
+        }
+
+        RunningState DefaultWorkUnit::UntagRunningState(Int32 Tagged) const
+        {
+            UInt32 Epoch = FrameEpoch ? *FrameEpoch : 0;
+            if((UInt32(Tagged)>>3) != (Epoch & (0xFFFFFFFFu>>3))) // Set in an earlier frame, so logically reset
+                { return NotStarted; }
+            return (RunningState)(Tagged & 7);
+        }
+
+        DefaultWorkUnit::DefaultWorkUnit() : CurrentRunningState(NotStarted), FrameEpoch(0), RemainingDependencies(0), SeededEpoch(0)
             {}
 
         DefaultWorkUnit::~DefaultWorkUnit()
@@ -120,25 +134,56 @@ namespace Mezzanine
             return true;
         }
 
+        void DefaultWorkUnit::SetRemainingDependencyCount(const Int32& Count)
+        {
+            RemainingDependencies = Count;
+            SeededEpoch = FrameEpoch ? *FrameEpoch+1 : 0;
+        }
+
+        Int32 DefaultWorkUnit::DecrementRemainingDependencyCount()
+            { return AtomicAdd(&RemainingDependencies,-1) - 1; }
+
+        Int32 DefaultWorkUnit::GetRemainingDependencyCount() const
+            { return RemainingDependencies; }
+
         /////////////////////////////////////////////////////////////////////////////////////////////
         // Work with the ownership and RunningState
         RunningState DefaultWorkUnit::TakeOwnerShip()
         {
-            if(!IsEveryDependencyComplete())
-                { return NotStarted; }
+            if(SeededEpoch && *FrameEpoch+1-SeededEpoch<=1) // SeededEpoch is only set while following an epoch
+            {
+                if(0<RemainingDependencies)
+                    { return NotStarted; }
+            }else if(!IsEveryDependencyComplete()){
+                return NotStarted; // No scheduler has counted the dependencies for this frame
+            }
 
-            if(NotStarted ==  AtomicCompareAndSwap32(&CurrentRunningState, NotStarted, Running) )
+            Int32 Observed = CurrentRunningState;
+            if(NotStarted!=UntagRunningState(Observed))
+                { return NotStarted; }
+            if(Observed == AtomicCompareAndSwap32(&CurrentRunningState, Observed, TagRunningState(Running)) )
                 { return Starting; } // This is the only place a starting should be generated, and it is never placed in CurrentRunningState
 
             return NotStarted;
         }
 
         RunningState DefaultWorkUnit::GetRunningState() const
-            { return (RunningState)CurrentRunningState; } // This only works because we set all of in RunningState to be unsigned.
+            { return UntagRunningState(CurrentRunningState); }
 
         void DefaultWorkUnit::PrepareForNextFrame()
-            //{ while(CurrentRunningState!=AtomicCompareAndSwap(&CurrentRunningState,CurrentRunningState,NotStarted)); }
-            { CurrentRunningState=NotStarted; }
+            { CurrentRunningState=TagRunningState(NotStarted); }
+
+        void DefaultWorkUnit::MarkComplete()
+            { CurrentRunningState=TagRunningState(Complete); }
+
+        bool DefaultWorkUnit::UseFrameEpoch(const Whole* Epoch)
+        {
+            RunningState Current = GetRunningState();
+            FrameEpoch = Epoch;
+            CurrentRunningState = TagRunningState(Current); // Keep the same logical state under the new counter
+            SeededEpoch = 0; // Any count was for another counter
+            return true;
+        }
 
         /////////////////////////////////////////////////////////////////////////////////////////////
         // Work with the performance log
@@ -164,7 +209,11 @@ namespace Mezzanine
             this->DoWork(CurrentThreadStorage);
             MaxInt End = Mezzanine::GetTimeStamp();
             this->GetPerformanceLog().Insert( Whole(End-Begin)); // A whole is usually a 32 bit type, which is fine unless a single workunit runs for 35 minutes.
-            CurrentRunningState = Complete;
+            CurrentRunningState = TagRunningState(Complete);
+
+            FrameScheduler* Scheduler = CurrentThreadStorage.GetFrameScheduler();
+            if(Scheduler)
+                { Scheduler->ReleaseDependentsOf(this, &CurrentThreadStorage); }
 
             #ifdef MEZZ_DEBUG
             Out << "<WorkUnitEnd EndTimeStamp=\"" << End << "\" Duration=\"" << (End-Begin) << "\" DurationStored=\"" << Whole(End-Begin) << "\" />" << std::endl;
@@ -173,7 +222,10 @@ namespace Mezzanine
         }
 
         WorkUnitKey DefaultWorkUnit::GetSortingKey(FrameScheduler& SchedulerToCount)
-            { return WorkUnitKey( this->GetDependentCount(SchedulerToCount), GetPerformanceLog().GetAverage(), this); }
+        {
+            return WorkUnitKey( this->GetDependentCount(SchedulerToCount), GetPerformanceLog().GetAverage(), this,
+                                SchedulerToCount.GetCriticalPathSorting() ? SchedulerToCount.GetCriticalPathOf(this) : 0 );
+        }
 
     }//Threading
 }//Mezzanine
@@ -112,6 +112,21 @@ namespace Mezzanine
                 /// @return This returns true if all of this WorkUnits dependencies have completed execution and false otherwise.
                 virtual bool IsEveryDependencyComplete() = 0;
 
+                /// @brief Set how many dependencies must still complete this frame before this WorkUnit can start.
+                /// @param Count The amount of scheduled dependencies that have not completed yet.
+                /// @details The @ref FrameScheduler sets this while preparing each frame, then each dependency lowers it by
+                /// one as it completes. This lets the scheduler know when a WorkUnit is ready without re-reading the state
+                /// of every dependency.
+                virtual void SetRemainingDependencyCount(const Int32& Count) = 0;
+
+                /// @brief Atomically lower the amount of dependencies this is waiting on by one.
+                /// @return The amount of dependencies still outstanding after the decrement, when this is 0 the WorkUnit is ready to run.
+                virtual Int32 DecrementRemainingDependencyCount() = 0;
+
+                /// @brief How many dependencies must still complete this frame before this WorkUnit can start.
+                /// @return An Int32 with the count, this can change at any time during a frame and should be considered stale immediately.
+                virtual Int32 GetRemainingDependencyCount() const = 0;
+
 
                 /////////////////////////////////////////////////////////////////////////////////////////////
                 // Work with the ownership and RunningState
@@ -127,6 +142,19 @@ namespace Mezzanine
                 /// @brief This resets the running state and takes any further action required to use the WorkUnit again.
                 virtual void PrepareForNextFrame() = 0;
 
+                /// @brief Set the RunningState to Complete for the current frame without doing any work.
+                /// @details The @ref FrameScheduler uses this when pipelining frames, for a WorkUnit whose work for this frame was
+                /// already done during the previous frame.
+                virtual void MarkComplete() = 0;
+
+                /// @brief Tie the RunningState of this WorkUnit to a frame counter, so that advancing the counter resets it.
+                /// @param Epoch A pointer to a counter that changes once between each frame, or 0 to stop following one.
+                /// @details The @ref FrameScheduler calls this when a WorkUnit is added or removed. If this returns true, the
+                /// scheduler will not call @ref PrepareForNextFrame between frames. That makes resetting any amount of WorkUnits
+                /// take the same tiny amount of time.
+                /// @return True if this will treat every change in the counter as a reset, false if @ref PrepareForNextFrame must still be called.
+                virtual bool UseFrameEpoch(const Whole* Epoch) = 0;
+
 
                 /////////////////////////////////////////////////////////////////////////////////////////////
                 // Work with the preformance log
@@ -169,8 +197,32 @@ namespace Mezzanine
                 std::vector<iWorkUnit*> Dependencies;
 
                 /// @brief This controls do work with this after it has.
+                /// @details The low 3 bits are a @ref RunningState and the rest are the low bits of the frame epoch it was set in.
+                /// If the epoch does not match the current one this is not started, no matter what the state bits say.
                 Int32 CurrentRunningState;
 
+                /// @brief The frame counter this follows, if any. If this is 0 the epoch is always 0.
+                const Whole* FrameEpoch;
+
+                /// @brief How many dependencies have not completed yet this frame, only changed atomically while a frame runs.
+                Int32 RemainingDependencies;
+
+                /// @brief One more than the frame epoch RemainingDependencies was last set in, or 0 if it has not been set
+                /// since this started following an epoch.
+                /// @details The scheduler sets the count during the frame before the one it is for, or while preparing that
+                /// frame, so the count is trusted if it was set in the current epoch or the one before.
+                Whole SeededEpoch;
+
+                /// @brief Combine a RunningState with the current frame epoch in the form stored in CurrentRunningState.
+                /// @param State The RunningState to store.
+                /// @return A value suitable for assigning to CurrentRunningState.
+                Int32 TagRunningState(RunningState State) const;
+
+                /// @brief Get the RunningState stored in a value of CurrentRunningState, taking the epoch into account.
+                /// @param Tagged A value read from CurrentRunningState.
+                /// @return The RunningState or NotStarted if Tagged is from an earlier frame.
+                RunningState UntagRunningState(Int32 Tagged) const;
+
                 /////////////////////////////////////////////////////////////////////////////////////////////
                 // The Simple Stuff
             private:
@@ -211,15 +263,29 @@ namespace Mezzanine
 
                 virtual bool IsEveryDependencyComplete();
 
+                virtual void SetRemainingDependencyCount(const Int32& Count);
+
+                virtual Int32 DecrementRemainingDependencyCount();
+
+                virtual Int32 GetRemainingDependencyCount() const;
+
                 /////////////////////////////////////////////////////////////////////////////////////////////
                 // Work with the ownership and RunningState
             public:
+                /// @copydoc iWorkUnit::TakeOwnerShip
+                /// @details When a @ref FrameScheduler has set the remaining dependency count for this frame only that count
+                /// is checked. Otherwise, such as outside a scheduler or before the scheduler has prepared a frame with this,
+                /// the state of every dependency is checked with @ref IsEveryDependencyComplete.
                 virtual RunningState TakeOwnerShip();
 
                 virtual RunningState GetRunningState() const;
 
                 virtual void PrepareForNextFrame();
 
+                virtual void MarkComplete();
+
+                virtual bool UseFrameEpoch(const Whole* Epoch);
+
                 /////////////////////////////////////////////////////////////////////////////////////////////
                 // Work with the performance log
             public:
@@ -238,7 +304,8 @@ namespace Mezzanine
                 /// as and an attribute. This causes all the log output to be valid xml as long
                 /// no '<' or '>' are emitted.
                 /// @n @n
-                ///
+                /// Once the work is complete the @ref FrameScheduler that owns CurrentThreadStorage is told, so it can
+                /// release any WorkUnits that were only waiting on this one.
                 virtual void operator() (DefaultThreadSpecificStorage::Type& CurrentThreadStorage);
 
                 virtual WorkUnitKey GetSortingKey(FrameScheduler &SchedulerToCount);
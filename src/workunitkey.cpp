@@ -52,11 +52,11 @@ namespace Mezzanine
     namespace Threading
     {
         WorkUnitKey::WorkUnitKey()
-            : Unit(0), Dependers(0), Time(0)
+            : Unit(0), Dependers(0), Time(0), CriticalPath(0)
             {}
 
-        WorkUnitKey::WorkUnitKey(const Whole& Dependers_, const Whole& Time_, iWorkUnit* WorkUnit_)
-            : Unit(WorkUnit_), Dependers(Dependers_), Time(Time_)
+        WorkUnitKey::WorkUnitKey(const Whole& Dependers_, const Whole& Time_, iWorkUnit* WorkUnit_, const Whole& CriticalPath_)
+            : Unit(WorkUnit_), Dependers(Dependers_), Time(Time_), CriticalPath(CriticalPath_)
             {}
 
         WorkUnitKey::~WorkUnitKey()
@@ -64,6 +64,10 @@ namespace Mezzanine
 
         bool WorkUnitKey::operator< (const WorkUnitKey& rhs ) const
         {
+            if (this->CriticalPath < rhs.CriticalPath) // reduce priority of Items with less work waiting on them
+                { return true; }
+            if (this->CriticalPath > rhs.CriticalPath)
+                { return false; }
             if (this->Dependers < rhs.Dependers) // reduce priority of Items with fewer dependents
                 { return true; }
             if (this->Dependers == rhs.Dependers)
@@ -79,6 +79,14 @@ namespace Mezzanine
                 /// in parrellel.
                 Whole Time;
 
+                /// @brief The length of the longest chain of work that cannot finish until the target workunit does.
+                /// @details This is the upward rank used by list schedulers like HEFT. It is the execution time of the
+                /// target workunit plus the largest of this value among the workunits that depend on it, so it measures
+                /// how much serialized work is left behind this workunit if it is delayed. When the
+                /// @ref Mezzanine::Threading::FrameScheduler "FrameScheduler" is not sorting by critical path this is left
+                /// at 0 and has no effect on ordering.
+                Whole CriticalPath;
+
                 /// @brief Default Constructor
                 /// @details This creates an empty and quite useless Key, needs to be filled with data before being useful.
                 WorkUnitKey();
@@ -87,14 +95,18 @@ namespace Mezzanine
                 /// @param Dependers_ How many items depend on this. This needs to be calculated the same for all WorkUnitKeys.
                 /// @param Time_ How long is this workunit expected to execute for. This needs to be calculated the same for all WorkUnitKeys.
                 /// @param WorkUnit_ A pointer to the workunit in question.
-                WorkUnitKey(const Whole& Dependers_, const Whole& Time_, iWorkUnit* WorkUnit_);
+                /// @param CriticalPath_ The length of the longest chain of work starting at this workunit, or 0 to sort only on the other fields.
+                WorkUnitKey(const Whole& Dependers_, const Whole& Time_, iWorkUnit* WorkUnit_, const Whole& CriticalPath_ = 0);
 
                 /// @brief Destructor
                 virtual ~WorkUnitKey();
 
                 /// @brief The function that does the comparison in most containers.
                 /// @param rhs The right hand WorkUnitKey when using <.
-                /// @details This enforces the algorithm that sorts workunits. The workunit with the most
+                /// @details If critical paths have been calculated the WorkUnit heading the longest chain of
+                /// remaining work is prioritized first and the rest of this algorithm only breaks ties.
+                /// @n @n
+                /// This enforces the algorithm that sorts workunits. The workunit with the most
                 /// other work units depending on it is priotized first. Because the longest delays in
                 /// execution time can be introduced if WorkUnits are waiting for a dependency and it is
                 /// poorly scheduled, this can results in single threaded execution when more could have
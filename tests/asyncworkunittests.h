@@ -79,6 +79,103 @@ String GetPerfString(double IOSize, double Duration)
 }
 
 
+/// @brief An asynchronous WorkUnit that starts a thread which sleeps and then completes it.
+class SleepingAsyncWorkUnit : public iAsynchronousWorkUnit
+{
+    public:
+        /// @brief The thread doing the asynchronous work, if started.
+        Thread* Sleeper;
+
+        /// @brief How many microseconds the asynchronous work takes.
+        Whole Length;
+
+        /// @brief Create one
+        /// @param Length_ How many microseconds the asynchronous work takes.
+        SleepingAsyncWorkUnit(Whole Length_) : Sleeper(0), Length(Length_)
+            { }
+
+        /// @brief The asynchronous work, sleep then complete.
+        /// @param Unit The SleepingAsyncWorkUnit to complete.
+        static void Sleep(void* Unit)
+        {
+            SleepingAsyncWorkUnit& Sleeping = *((SleepingAsyncWorkUnit*)Unit);
+            Mezzanine::Threading::this_thread::sleep_for(Sleeping.Length);
+            Sleeping.CompleteAsynchronousWork();
+        }
+
+        /// @brief Start the asynchronous work unless it is already running.
+        void Begin()
+        {
+            if(BeginAsynchronousWork())
+            {
+                if(Sleeper) // From an earlier run
+                {
+                    Sleeper->join();
+                    delete Sleeper;
+                }
+                Sleeper = new Thread(Sleep,this);
+            }
+        }
+
+        /// @brief Nothing to do, Begin starts the work.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+            { }
+
+        /// @brief Waits for and cleans up the asynchronous thread.
+        virtual ~SleepingAsyncWorkUnit()
+        {
+            if(Sleeper)
+            {
+                Sleeper->join();
+                delete Sleeper;
+            }
+        }
+};
+
+/// @brief A WorkUnit that records whether an asynchronous WorkUnit it depends on was done when this ran.
+class AfterAsyncWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief The asynchronous WorkUnit this depends on.
+        iAsynchronousWorkUnit* Async;
+
+        /// @brief How many times this ran.
+        Int32 Runs;
+
+        /// @brief How many times this ran before Async was done.
+        Int32 Early;
+
+        /// @brief Create one
+        /// @param Async_ The asynchronous WorkUnit this depends on.
+        AfterAsyncWorkUnit(iAsynchronousWorkUnit* Async_) : Async(Async_), Runs(0), Early(0)
+            { AddDependency(Async); }
+
+        /// @brief Check Async and count.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+        {
+            if(Complete!=Async->IsWorkDone())
+                { Early++; }
+            Runs++;
+        }
+};
+
+/// @brief A WorkUnit that sleeps, to keep a frame running.
+class SlowWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief How many microseconds this sleeps.
+        Whole Length;
+
+        /// @brief Create one
+        /// @param Length_ How many microseconds this sleeps.
+        SlowWorkUnit(Whole Length_) : Length(Length_)
+            { }
+
+        /// @brief Sleep.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+            { Mezzanine::Threading::this_thread::sleep_for(Length); }
+};
+
 /// @brief Tests for the asyncronous workunits
 class asyncworkunittests : public UnitTestGroup
 {
@@ -132,15 +229,9 @@ class asyncworkunittests : public UnitTestGroup
             DefaultThreadSpecificStorage::Type AResource(&Scheduler1);
             TestResult temp = Testing::Success;
             TimeStarted = GetTimeStamp();
-            while(Complete!=Testable.IsWorkDone())
-            {
-                Testable.DoWork(AResource);
-                if(GetTimeStamp()>TimeStarted+MaxTime*20)
-                {
-                    temp=Testing::Failed;
-                    break;
-                }
-            }
+            if(Complete!=Testable.WaitForAsynchronousWork() || GetTimeStamp()>TimeStarted+MaxTime*20)
+                { temp=Testing::Failed; }
+            Testable.DoWork(AResource);
             //AddTestResult("DAGFrameScheduler::Async::ReadWriteTimeParity", temp);
             TEST_RESULT(temp,"ReadWriteTimeParity")
 
@@ -170,6 +261,68 @@ class asyncworkunittests : public UnitTestGroup
             File1b.close();
             File2b.close();
             File3b.close();
+
+            {
+                TestOutput << "Creating a 200 millisecond asynchronous WorkUnit and a WorkUnit depending on it on 2 threads." << endl;
+                stringstream LogCache;
+                FrameScheduler CompletionScheduler(&LogCache,2);
+                CompletionScheduler.SetFrameLength(10000);
+                SleepingAsyncWorkUnit* Async = new SleepingAsyncWorkUnit(200000);
+                AfterAsyncWorkUnit* After = new AfterAsyncWorkUnit(Async);
+                CompletionScheduler.AddWorkUnitMain(Async,"Async"); // The scheduler deletes these
+                CompletionScheduler.AddWorkUnitMain(After,"After");
+
+                Async->Begin();
+                Whole FramesWhileLoading = 0;
+                for(CompletionScheduler.DoOneFrame(); Running==Async->IsWorkDone(); CompletionScheduler.DoOneFrame())
+                    { FramesWhileLoading++; }
+                TestOutput << FramesWhileLoading << " frames ended while the asynchronous work was running, and the dependent ran "
+                           << After->Runs << " times, " << After->Early << " early." << endl;
+                TEST(1<FramesWhileLoading,"FramesRunWhileLoading");
+                TEST(0==After->Early,"DependentWaitsForLoad");
+                CompletionScheduler.DoOneFrame();
+                TEST(1<=After->Runs && 0==After->Early,"DependentRunsAfterLoad");
+
+                TestOutput << "Starting the asynchronous work on the same WorkUnit again." << endl;
+                Int32 RunsBefore = After->Runs;
+                Async->Begin();
+                FramesWhileLoading = 0;
+                for(CompletionScheduler.DoOneFrame(); Running==Async->IsWorkDone(); CompletionScheduler.DoOneFrame())
+                    { FramesWhileLoading++; }
+                TEST(1<FramesWhileLoading,"SecondLoadFramesRun");
+                TEST(0==After->Early,"SecondLoadDependentWaits");
+                CompletionScheduler.DoOneFrame();
+                TEST(RunsBefore<After->Runs && 0==After->Early,"SecondLoadDependentRuns");
+
+                TestOutput << "Running a frame with the asynchronous work completed between frames." << endl;
+                RunsBefore = After->Runs;
+                Async->Begin();
+                Async->WaitForAsynchronousWork();
+                MaxInt FrameStart = GetTimeStamp();
+                CompletionScheduler.DoOneFrame();
+                MaxInt FrameLength = GetTimeStamp()-FrameStart;
+                TEST(RunsBefore+1==After->Runs && 0==After->Early,"CompletedBetweenFrames");
+                TEST(FrameLength<200000,"NoWaitWhenComplete");
+            }
+
+            {
+                TestOutput << "Creating a 10 millisecond asynchronous WorkUnit with a dependent, and a 100 millisecond WorkUnit keeping the frame running." << endl;
+                stringstream LogCache;
+                FrameScheduler InFrameScheduler(&LogCache,2);
+                InFrameScheduler.SetFrameLength(0);
+                SleepingAsyncWorkUnit* Async = new SleepingAsyncWorkUnit(10000);
+                AfterAsyncWorkUnit* After = new AfterAsyncWorkUnit(Async);
+                InFrameScheduler.AddWorkUnitMain(Async,"Async");
+                InFrameScheduler.AddWorkUnitMain(After,"After");
+                InFrameScheduler.AddWorkUnitMain(new SlowWorkUnit(100000),"Slow");
+
+                Async->Begin();
+                InFrameScheduler.DoOneFrame();
+                TestOutput << "The dependent ran " << After->Runs << " times, " << After->Early << " early." << endl;
+                TEST(Complete==Async->IsWorkDone(),"CompletionInFrame");
+                TEST(1==After->Runs && 0==After->Early,"DependentReleasedInFrame");
+                TestOutput << endl;
+            }
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.
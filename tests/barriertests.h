@@ -70,6 +70,68 @@ void BarrierTestHelper(void* ThreadID)
     BarrierData2[Position]=BarrierData1[0]+BarrierData1[1]+BarrierData1[2]+BarrierData1[3];
 }
 
+/// @brief How many rounds ReuseTestHelper waits on a barrier.
+const Int32 BarrierRounds = 200;
+/// @brief Counts arrivals at a reused barrier across all rounds.
+Int32 BarrierArrivals = 0;
+/// @brief Counts how many times a thread got true from a reused barrier.
+Int32 BarrierTrips = 0;
+/// @brief Counts how many times a thread passed a reused barrier before every thread arrived.
+Int32 BarrierEarlyPasses = 0;
+
+/// @brief What each thread in ReuseTestHelper needs to know.
+struct BarrierReuseArgs
+{
+    /// @brief The barrier every thread waits on.
+    Barrier* Reused;
+    /// @brief How many threads wait on Reused.
+    Int32 ThreadCount;
+    /// @brief The index this thread waits with, or -1 to wait without one.
+    Int32 Index;
+};
+
+/// @brief Waits on the same barrier many times in a row, without ever resetting it.
+/// @param Args A pointer to the BarrierReuseArgs for this thread.
+void ReuseTestHelper(void* Args)
+{
+    BarrierReuseArgs& Arg = *((BarrierReuseArgs*)Args);
+    for(Int32 Round = 1; Round<=BarrierRounds; ++Round)
+    {
+        AtomicAdd(&BarrierArrivals,1);
+        if(-1==Arg.Index ? Arg.Reused->Wait() : Arg.Reused->Wait(Arg.Index))
+            { AtomicAdd(&BarrierTrips,1); }
+        if(AtomicAdd(&BarrierArrivals,0)<Round*Arg.ThreadCount)
+            { AtomicAdd(&BarrierEarlyPasses,1); }
+        -1==Arg.Index ? Arg.Reused->Wait() : Arg.Reused->Wait(Arg.Index); // So no thread can arrive for the next round before all have checked this one
+    }
+}
+
+/// @brief Has some threads wait on a barrier many times in a row and reports how it went in the counts above.
+/// @param Reused The barrier to wait on, it must be set to synchronize ThreadCount threads.
+/// @param ThreadCount How many threads to start.
+/// @param WithIndex Should threads pass their index when waiting.
+void RunReuseTest(Barrier& Reused, Int32 ThreadCount, bool WithIndex)
+{
+    BarrierArrivals = 0;
+    BarrierTrips = 0;
+    BarrierEarlyPasses = 0;
+    std::vector<BarrierReuseArgs> Args(ThreadCount);
+    std::vector<Mezzanine::Threading::Thread*> Threads;
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+    {
+        Args[Count].Reused = &Reused;
+        Args[Count].ThreadCount = ThreadCount;
+        Args[Count].Index = WithIndex ? Count : -1;
+    }
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+        { Threads.push_back(new Mezzanine::Threading::Thread(ReuseTestHelper, &Args[Count])); }
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+    {
+        Threads[Count]->join();
+        delete Threads[Count];
+    }
+}
+
 /// @brief Tests for the WorkUnit class
 class barriertests : public UnitTestGroup
 {
@@ -118,6 +180,32 @@ class barriertests : public UnitTestGroup
             TEST(100==BarrierData2[1], "BarrierThread2")
             TEST(100==BarrierData2[2], "BarrierThread3")
             TEST(100==BarrierData2[3], "BarrierThread4")
+
+            TestOutput << "Waiting on the same Barrier " << BarrierRounds << " times with 4 threads without resetting it between uses." << endl;
+            Barrier ReusedBarrier(4);
+            RunReuseTest(ReusedBarrier, 4, false);
+            TestOutput << "The Barrier tripped " << BarrierTrips << " times and threads passed it early " << BarrierEarlyPasses << " times." << endl;
+            TEST(BarrierRounds==BarrierTrips, "BarrierReusedTripsOncePerUse")
+            TEST(0==BarrierEarlyPasses, "BarrierReusedHoldsEveryUse")
+
+            TestOutput << "Waiting on the same TreeBarrier " << BarrierRounds << " times with 11 threads, passing an index and then without one." << endl;
+            TreeBarrier ReusedTree(11);
+            RunReuseTest(ReusedTree, 11, true);
+            TestOutput << "The TreeBarrier tripped " << BarrierTrips << " times and threads passed it early " << BarrierEarlyPasses << " times." << endl;
+            TEST(BarrierRounds==BarrierTrips, "TreeBarrierTripsOncePerUse")
+            TEST(0==BarrierEarlyPasses, "TreeBarrierHoldsEveryUse")
+            RunReuseTest(ReusedTree, 11, false);
+            TEST(BarrierRounds==BarrierTrips && 0==BarrierEarlyPasses, "TreeBarrierWithoutIndex")
+
+            TestOutput << "Changing the TreeBarrier to 3 threads." << endl;
+            ReusedTree.SetThreadSyncCount(3);
+            RunReuseTest(ReusedTree, 3, true);
+            TEST(BarrierRounds==BarrierTrips && 0==BarrierEarlyPasses, "TreeBarrierResized")
+
+            TestOutput << "Changing the TreeBarrier to 23 threads, more than it was built for." << endl;
+            ReusedTree.SetThreadSyncCount(23);
+            RunReuseTest(ReusedTree, 23, true);
+            TEST(BarrierRounds==BarrierTrips && 0==BarrierEarlyPasses, "TreeBarrierGrown")
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.
@@ -58,6 +58,64 @@ using namespace Mezzanine;
 using namespace Mezzanine::Testing;
 using namespace Mezzanine::Threading;
 
+/// @brief What each thread in BarrierBenchmarkHelper needs to know.
+struct BarrierBenchmarkArgs
+{
+    /// @brief The barrier being measured.
+    Barrier* Measured;
+    /// @brief The index this thread waits with.
+    Int32 Index;
+    /// @brief How many times to wait on Measured.
+    Whole Rounds;
+    /// @brief Set by the thread with index 0 once every thread has started.
+    MaxInt Start;
+    /// @brief Set by the thread with index 0 once every thread has finished its rounds.
+    MaxInt End;
+};
+
+/// @brief Waits on a barrier repeatedly as part of measuring it.
+/// @param Args A pointer to the BarrierBenchmarkArgs for this thread.
+void BarrierBenchmarkHelper(void* Args)
+{
+    BarrierBenchmarkArgs& Arg = *((BarrierBenchmarkArgs*)Args);
+    Arg.Measured->Wait(Arg.Index); // Every thread is running before any round is timed
+    if(0==Arg.Index)
+        { Arg.Start = GetTimeStamp(); }
+    for(Whole Round = 0; Round<Arg.Rounds; ++Round)
+        { Arg.Measured->Wait(Arg.Index); }
+    if(0==Arg.Index)
+        { Arg.End = GetTimeStamp(); }
+}
+
+/// @brief Measures how long it takes for some threads to wait on a barrier repeatedly.
+/// @param Measured The barrier to measure, this is set to synchronize ThreadCount threads.
+/// @param ThreadCount How many threads to wait with.
+/// @param Rounds How many times each thread waits on the barrier.
+/// @return The average microseconds per use of the barrier, not counting starting the threads.
+double BenchmarkBarrier(Barrier& Measured, Int32 ThreadCount, Whole Rounds)
+{
+    Measured.SetThreadSyncCount(ThreadCount);
+    std::vector<BarrierBenchmarkArgs> Args(ThreadCount);
+    std::vector<Thread*> Threads;
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+    {
+        Args[Count].Measured = &Measured;
+        Args[Count].Index = Count;
+        Args[Count].Rounds = Rounds;
+        Args[Count].Start = 0;
+        Args[Count].End = 0;
+    }
+
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+        { Threads.push_back(new Thread(BarrierBenchmarkHelper, &Args[Count])); }
+    for(Int32 Count = 0; Count<ThreadCount; ++Count)
+    {
+        Threads[Count]->join();
+        delete Threads[Count];
+    }
+    return double(Args[0].End-Args[0].Start)/double(Rounds);
+}
+
 /// @brief Tests the performance of specific components
 class dagperformancetests : public UnitTestGroup
 {
@@ -286,6 +344,21 @@ class dagperformancetests : public UnitTestGroup
 
             } // \Max framerate
 
+            { // Barriers
+                const Whole Rounds = 1000;
+                TestOutput << "Comparing a Barrier and a TreeBarrier, each used " << Rounds << " times by 2 to 64 threads. Times are the average microseconds per use after every thread has started." << endl
+                           << "Threads\tBarrier\tTreeBarrier" << endl;
+                for(Int32 ThreadCount = 2; ThreadCount<=64; ThreadCount*=2)
+                {
+                    Barrier Central(ThreadCount);
+                    TreeBarrier Tree(ThreadCount);
+                    double CentralTime = BenchmarkBarrier(Central, ThreadCount, Rounds);
+                    double TreeTime = BenchmarkBarrier(Tree, ThreadCount, Rounds);
+                    TestOutput << ThreadCount << "\t" << CentralTime << "\t" << TreeTime << endl;
+                }
+                TestOutput << endl;
+            } // \Barriers
+
         }
 
         /// @brief Since RunAutomaticTests implements no tests this does not true
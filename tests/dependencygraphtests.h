@@ -0,0 +1,147 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _dependencygraphtests_h
+#define _dependencygraphtests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+#include "monopolytests.h"
+#include "workunittests.h"
+
+/// @file
+/// @brief Tests of the frozen graph the FrameScheduler uses to look up dependencies and dependents
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief Tests for the DependencyGraph class
+class dependencygraphtests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "DependencyGraph"
+        virtual String Name()
+            { return String("DependencyGraph"); }
+
+        /// @brief Checks indexes, both directions of every edge and the topological order.
+        void RunAutomaticTests()
+        {
+            TestOutput << "Creating main WorkUnits A and B, affinity WorkUnit C, Monopoly M and unscheduled WorkUnit E:" << endl
+                 << "B --> A --> E" << endl
+                 << "C --> A, C --> B, M --> A, and B depends on A a second time" << endl;
+            PiMakerWorkUnit A(50,"A",false);
+            PiMakerWorkUnit B(50,"B",false);
+            PiMakerWorkUnit C(50,"C",false);
+            PiMakerWorkUnit E(50,"E",false);
+            PiMakerWorkUnit Stranger(50,"Stranger",false);
+            PiMakerMonopoly M(50,"M",false);
+            A.AddDependency(&E);
+            B.AddDependency(&A);
+            B.AddDependency(&A);
+            C.AddDependency(&A);
+            C.AddDependency(&B);
+            M.AddDependency(&A);
+
+            std::vector<WorkUnitKey> Main;
+            Main.push_back(WorkUnitKey(0,0,&A));
+            Main.push_back(WorkUnitKey(0,0,&B));
+            std::vector<WorkUnitKey> Affinity;
+            Affinity.push_back(WorkUnitKey(0,0,&C));
+            std::vector<MonopolyWorkUnit*> Monopolies;
+            Monopolies.push_back(&M);
+
+            DependencyGraph Graph;
+            Graph.Build(Main,Affinity,Monopolies);
+
+            TEST(Graph.GetUnitCount()==5,"UnitCount");
+            TEST(Graph.GetMainCount()==2,"MainCount");
+            TEST(Graph.GetScheduledCount()==4,"ScheduledCount");
+            TEST(Graph.IsMonopoly(3) && !Graph.IsMonopoly(2) && !Graph.IsMonopoly(4),"IsMonopoly");
+            TEST(Graph.GetIndexOf(&A)==0 && Graph.GetIndexOf(&B)==1,"MainIndexesFollowOrder");
+            TEST(Graph.GetIndexOf(&C)==2,"AffinityIndexFollowsMain");
+            TEST(Graph.GetIndexOf(&M)==3,"MonopolyIndexFollowsAffinity");
+            TEST(Graph.GetIndexOf(&E)==4,"UnscheduledIndexIsLast");
+            TEST(Graph.GetIndexOf(&Stranger)==DependencyGraph::NotFound,"StrangerNotFound");
+            TEST(Graph.GetUnit(1)==&B,"GetUnit");
+
+            TEST(Graph.DependenciesEnd(1)-Graph.DependenciesBegin(1)==1,"RepeatedDependencyRecordedOnce");
+            TEST(Graph.DependenciesEnd(2)-Graph.DependenciesBegin(2)==2,"AffinityDependencies");
+            TEST(Graph.DependenciesEnd(3)-Graph.DependenciesBegin(3)==1 && *Graph.DependenciesBegin(3)==0,"MonopolyDependencies");
+            TEST(Graph.DependenciesEnd(4)==Graph.DependenciesBegin(4),"UnscheduledHasNoDependencies");
+
+            TEST(Graph.GetDependentCount(0)==3,"ADependents");
+            std::vector<Whole> DependentsOfA(Graph.DependentsBegin(0),Graph.DependentsEnd(0));
+            TEST(std::find(DependentsOfA.begin(),DependentsOfA.end(),Whole(1))!=DependentsOfA.end(),"BDependsOnA");
+            TEST(std::find(DependentsOfA.begin(),DependentsOfA.end(),Whole(2))!=DependentsOfA.end(),"CDependsOnA");
+            TEST(std::find(DependentsOfA.begin(),DependentsOfA.end(),Whole(3))!=DependentsOfA.end(),"MDependsOnA");
+            TEST(Graph.GetDependentCount(1)==1 && *Graph.DependentsBegin(1)==2,"BDependents");
+            TEST(Graph.GetDependentCount(2)==0,"CDependents");
+            TEST(Graph.GetDependentCount(4)==1 && *Graph.DependentsBegin(4)==0,"EDependents");
+
+            std::vector<Whole> Order(Graph.OrderBegin(),Graph.OrderEnd());
+            TestOutput << "Topological order:";
+            for(std::vector<Whole>::iterator Iter=Order.begin(); Iter!=Order.end(); ++Iter)
+                { TestOutput << " " << *Iter; }
+            TestOutput << endl;
+            TEST(Order.size()==5,"OrderHasEveryUnit");
+            std::vector<Whole> Position(Order.size());
+            for(Whole Counter=0; Counter<Order.size(); ++Counter)
+                { Position[Order[Counter]] = Counter; }
+            TEST(Position[4]<Position[0] && Position[0]<Position[1] && Position[1]<Position[2] && Position[0]<Position[3],"OrderRespectsDependencies");
+
+            TestOutput << "Adding a cycle between A and B, they and C and M which wait on them cannot be ordered." << endl;
+            A.AddDependency(&B);
+            Graph.Build(Main,Affinity,Monopolies);
+            TEST(Graph.OrderEnd()-Graph.OrderBegin()==1,"CycleLeftOutOfOrder");
+
+            Graph.Clear();
+            TEST(Graph.GetUnitCount()==0 && Graph.GetScheduledCount()==0,"Clear");
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return returns true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
@@ -0,0 +1,214 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _forkjoingrouptests_h
+#define _forkjoingrouptests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+
+/// @file
+/// @brief Tests of WorkUnits forking tasks and joining them.
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief A range of a shared array for a forked task to sum.
+struct ForkedSumRange
+{
+    /// @brief The numbers being summed.
+    const vector<Int32>* Numbers;
+    /// @brief The first index to sum.
+    Whole Begin;
+    /// @brief One past the last index to sum.
+    Whole End;
+    /// @brief The sum of the range, once the task has completed.
+    Int32 Sum;
+    /// @brief The storage of the thread that summed the range.
+    DefaultThreadSpecificStorage::Type* RanOn;
+    /// @brief When not 0, ranges longer than this are split in two and forked again.
+    Whole SplitAbove;
+};
+
+/// @brief Sums a ForkedSumRange, splitting it into nested tasks if it is long.
+void ForkedSum(void* Argument, DefaultThreadSpecificStorage::Type& CurrentThread)
+{
+    ForkedSumRange& Range = *((ForkedSumRange*)Argument);
+    Range.RanOn = &CurrentThread;
+    Range.Sum = 0;
+    if(Range.SplitAbove && Range.End-Range.Begin>Range.SplitAbove)
+    {
+        Whole Middle = (Range.Begin+Range.End)/2;
+        ForkedSumRange Halves[2] = { Range, Range };
+        Halves[0].End = Middle;
+        Halves[1].Begin = Middle;
+        ForkJoinGroup Group(CurrentThread);
+        Group.Fork(ForkedSum, &Halves[0]);
+        Group.Fork(ForkedSum, &Halves[1]);
+        Group.Join();
+        Range.Sum = Halves[0].Sum + Halves[1].Sum;
+        return;
+    }
+    for(Whole Index = Range.Begin; Index<Range.End; ++Index)
+        { Range.Sum += (*Range.Numbers)[Index]; }
+    Mezzanine::Threading::this_thread::sleep_for(200); // Long enough that idle threads have a chance to help
+}
+
+/// @brief A WorkUnit that sums an array by forking a task for each part of it.
+class ForkingWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief The numbers to sum.
+        vector<Int32> Numbers;
+        /// @brief One range per forked task.
+        vector<ForkedSumRange> Ranges;
+        /// @brief The sum found by the last run.
+        Int32 Sum;
+        /// @brief How many forked tasks ran on a thread other than the one running this, across all runs.
+        Int32 Helped;
+
+        /// @brief Constructor
+        /// @param Count How many numbers to sum.
+        /// @param Parts How many tasks to fork.
+        /// @param SplitAbove Passed to each ForkedSumRange.
+        ForkingWorkUnit(Whole Count, Whole Parts, Whole SplitAbove = 0)
+            : Sum(0), Helped(0)
+        {
+            for(Whole Counter = 0; Counter<Count; ++Counter)
+                { Numbers.push_back(Int32(Counter)); }
+            for(Whole Part = 0; Part<Parts; ++Part)
+            {
+                ForkedSumRange Range = { &Numbers, Count*Part/Parts, Count*(Part+1)/Parts, 0, 0, SplitAbove };
+                Ranges.push_back(Range);
+            }
+        }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~ForkingWorkUnit()
+            { }
+
+        /// @brief Fork a task per range, join them and add up their results.
+        /// @param CurrentThreadStorage The storage the tasks are forked from.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            ForkJoinGroup Group(CurrentThreadStorage);
+            for(vector<ForkedSumRange>::iterator Iter = Ranges.begin(); Iter!=Ranges.end(); ++Iter)
+                { Group.Fork(ForkedSum, &(*Iter)); }
+            Group.Join();
+            Sum = 0;
+            for(vector<ForkedSumRange>::iterator Iter = Ranges.begin(); Iter!=Ranges.end(); ++Iter)
+            {
+                Sum += Iter->Sum;
+                if(Iter->RanOn!=&CurrentThreadStorage)
+                    { Helped++; }
+            }
+        }
+};
+
+/// @brief Tests for the ForkJoinGroup class
+class forkjoingrouptests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "ForkJoinGroup"
+        virtual String Name()
+            { return String("ForkJoinGroup"); }
+
+        /// @brief Test that forked tasks each run once and are all complete after joining, with and without a running frame.
+        void RunAutomaticTests()
+        {
+            const Whole Count = 1000;
+            const Int32 Expected = Int32(Count*(Count-1)/2);
+
+            TestOutput << dec << "Forking 4 tasks from storage without a scheduler, they should run as they are forked." << endl;
+            {
+                ForkingWorkUnit Unit(Count,4);
+                ThreadSpecificStorage Lone(0);
+                Unit.DoWork(Lone);
+                TEST(Expected==Unit.Sum,"WithoutScheduler");
+                TEST(0==Unit.Helped,"WithoutSchedulerRunsInline");
+            }
+
+            TestOutput << "Forking 4 tasks between frames, joining should run them all on the calling thread." << endl;
+            {
+                stringstream LogCache;
+                FrameScheduler Idle(&LogCache,4);
+                ForkingWorkUnit Unit(Count,4);
+                ThreadSpecificStorage Storage(&Idle);
+                Unit.DoWork(Storage);
+                TEST(Expected==Unit.Sum,"BetweenFrames");
+                TEST(0==Unit.Helped,"BetweenFramesJoinRunsAll");
+                TEST(0==Idle.GetOutstandingWorkUnitCount(),"BetweenFramesOutstandingRestored");
+            }
+
+            const Whole Frames = 20;
+            TestOutput << "Running " << Frames << " frames on 4 threads of a WorkUnit forking 16 tasks, and one forking 4 tasks that each split into 4 more." << endl;
+            {
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,4);
+                Scheduler.SetFrameLength(0);
+                ForkingWorkUnit* Flat = new ForkingWorkUnit(Count,16);
+                ForkingWorkUnit* Nested = new ForkingWorkUnit(Count,4,Count/16);
+                Scheduler.AddWorkUnitMain(Flat,"Flat"); // The scheduler deletes these
+                Scheduler.AddWorkUnitMain(Nested,"Nested");
+                bool FlatCorrect = true;
+                bool NestedCorrect = true;
+                for(Whole Frame = 0; Frame<Frames; ++Frame)
+                {
+                    Scheduler.DoOneFrame();
+                    FlatCorrect = FlatCorrect && Expected==Flat->Sum;
+                    NestedCorrect = NestedCorrect && Expected==Nested->Sum;
+                }
+                TestOutput << "Other threads ran " << Flat->Helped << " of the flat WorkUnit's tasks and " << Nested->Helped
+                           << " of the nested WorkUnit's top level tasks." << endl;
+                TEST(FlatCorrect,"FlatSumEachFrame");
+                TEST(NestedCorrect,"NestedSumEachFrame");
+            }
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return returns true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
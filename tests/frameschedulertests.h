@@ -88,6 +88,71 @@ class PausesWorkUnit : public DefaultWorkUnit
         }
 };
 
+/// @brief A workunit that remembers the NUMA node of the resources of the thread that last ran it.
+class RecordsNodeWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief The node reported by the ThreadSpecificStorage it last ran with, -2 if it has not run.
+        Mezzanine::Int32 Node;
+
+        /// @brief Create one of these workunit
+        RecordsNodeWorkUnit() : Node(-2)
+            { }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~RecordsNodeWorkUnit()
+            { }
+
+        /// @brief Record the node.
+        /// @param CurrentThreadStorage The resources of the thread running this.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+            { Node = CurrentThreadStorage.GetNumaNode(); }
+};
+
+/// @brief A workunit that counts its runs and checks it never gets ahead of another WorkUnit.
+class CountsRunsWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief How many times this has completed its work.
+        Mezzanine::Int32 Runs;
+
+        /// @brief How many microseconds each run sleeps for.
+        Mezzanine::Whole Length;
+
+        /// @brief If not null, each run of this expects Leader to have run as many times as this will have.
+        CountsRunsWorkUnit* Leader;
+
+        /// @brief How many runs Leader is allowed to be behind by, 0 for a dependency and 1 for a cross-frame dependency.
+        Mezzanine::Int32 Lag;
+
+        /// @brief How many runs started before Leader had run enough times.
+        Mezzanine::Int32 Violations;
+
+        /// @brief Create one of these workunit
+        /// @param Length_ How many microseconds each run takes.
+        /// @param Leader_ A WorkUnit this should never get ahead of, if any.
+        /// @param Lag_ How many runs the Leader may be behind.
+        CountsRunsWorkUnit(Mezzanine::Whole Length_ = 0, CountsRunsWorkUnit* Leader_ = 0, Mezzanine::Int32 Lag_ = 0)
+            : Runs(0), Length(Length_), Leader(Leader_), Lag(Lag_), Violations(0)
+            { }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~CountsRunsWorkUnit()
+            { }
+
+        /// @brief Check the Leader, wait and count.
+        /// @param CurrentThreadStorage Ignored.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            (void)CurrentThreadStorage;
+            if(Leader && AtomicAdd(&Leader->Runs,0)+Lag < AtomicAdd(&Runs,0)+1)
+                { AtomicAdd(&Violations,1); }
+            if(Length)
+                { Mezzanine::Threading::this_thread::sleep_for(Length); }
+            AtomicAdd(&Runs,1);
+        }
+};
+
 /// @brief a monopoly version of the pausing workunit
 class PauseMonopoly : public MonopolyWorkUnit
 {
@@ -186,6 +251,39 @@ class LoggerCheckWorkUnit : public DefaultWorkUnit
 };
 
 
+/// @brief Counts how often it runs and if it ever started before one of its dependencies completed.
+class OrderCheckWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief How many times DoWork has been called.
+        Int32 RunCount;
+
+        /// @brief How many times this ran when a dependency was not complete.
+        Int32 Violations;
+
+        /// @brief Create one with clean counts.
+        OrderCheckWorkUnit() : RunCount(0), Violations(0)
+            { }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~OrderCheckWorkUnit()
+            { }
+
+        /// @brief Check every dependency is complete, then spin briefly so other threads have a chance to steal.
+        /// @param CurrentThreadStorage ignored
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+        {
+            for(Whole Counter = 0; Counter<GetImmediateDependencyCount(); ++Counter)
+            {
+                if(Complete!=GetDependency(Counter)->GetRunningState())
+                    { Violations++; }
+            }
+            RunCount++;
+            for(volatile Whole Spin = 0; Spin<2000; ++Spin)
+                {}
+        }
+};
+
 /// @brief Tests for the Framescheduler class
 class frameschedulertests : public UnitTestGroup
 {
@@ -1100,6 +1198,439 @@ class frameschedulertests : public UnitTestGroup
                      ,"GetThreadUsableLogger");
             }
 
+            { // Work Stealing
+                TestOutput << "Creating 64 WorkUnits in 8 layers, each depending on two in the layer before, and running 10 frames with 4 work stealing threads." << endl;
+                stringstream LogCache;
+                FrameScheduler StealingScheduler(&LogCache,4);
+                StealingScheduler.SetWorkStealing(true);
+                TEST(StealingScheduler.GetWorkStealing(),"WorkStealing::Enabled");
+                std::vector<OrderCheckWorkUnit*> Units;
+                for(Whole Counter = 0; Counter<64; ++Counter)
+                {
+                    OrderCheckWorkUnit* Unit = new OrderCheckWorkUnit;
+                    if(Counter>=8)
+                    {
+                        Unit->AddDependency(Units[Counter-8]);
+                        Unit->AddDependency(Units[(Counter-8)/8*8 + (Counter+3)%8]);
+                    }
+                    Units.push_back(Unit);
+                    StealingScheduler.AddWorkUnitMain(Unit, "Stealing" + ToString(Counter)); // The scheduler deletes these
+                }
+                StealingScheduler.SetFrameLength(0);
+                StealingScheduler.SortWorkUnitsMain();
+                for(Whole Counter = 0; Counter<10; ++Counter)
+                    { StealingScheduler.DoOneFrame(); }
+
+                Whole RanEachFrame = 0;
+                Whole Violations = 0;
+                for(std::vector<OrderCheckWorkUnit*>::iterator Iter = Units.begin(); Iter!=Units.end(); ++Iter)
+                {
+                    if(10==(*Iter)->RunCount)
+                        { RanEachFrame++; }
+                    Violations += (*Iter)->Violations;
+                }
+                TestOutput << RanEachFrame << " of 64 WorkUnits ran exactly once each frame and " << Violations << " ran before a dependency completed." << endl << endl;
+                TEST(64==RanEachFrame,"WorkStealing::EachRanOncePerFrame");
+                TEST(0==Violations,"WorkStealing::DependenciesRespected");
+            } // \Work Stealing
+
+            { // Changing Thread Count
+                const Whole ThreadCounts[] = { 4, 2, 6, 1, 8, 3, 3, 5 };
+                TestOutput << "Running the same 64 WorkUnits for 8 frames, changing the thread count between frames, with threads synchronized by a combining tree if barriers are used." << endl;
+                stringstream LogCache;
+                FrameScheduler ResizingScheduler(&LogCache,ThreadCounts[0],CombiningTreeBarrier);
+                TEST(CombiningTreeBarrier==ResizingScheduler.GetBarrierAlgorithm(),"ThreadCount::BarrierAlgorithmSelected");
+                std::vector<OrderCheckWorkUnit*> Units;
+                for(Whole Counter = 0; Counter<64; ++Counter)
+                {
+                    OrderCheckWorkUnit* Unit = new OrderCheckWorkUnit;
+                    if(Counter>=8)
+                        { Unit->AddDependency(Units[Counter-8]); }
+                    Units.push_back(Unit);
+                    ResizingScheduler.AddWorkUnitMain(Unit, "Resizing" + ToString(Counter)); // The scheduler deletes these
+                }
+                ResizingScheduler.SetFrameLength(0);
+                ResizingScheduler.SortWorkUnitsMain();
+                for(Whole Counter = 0; Counter<8; ++Counter)
+                {
+                    ResizingScheduler.SetThreadCount(ThreadCounts[Counter]);
+                    ResizingScheduler.DoOneFrame();
+                }
+
+                Whole RanEachFrame = 0;
+                Whole Violations = 0;
+                for(std::vector<OrderCheckWorkUnit*>::iterator Iter = Units.begin(); Iter!=Units.end(); ++Iter)
+                {
+                    if(8==(*Iter)->RunCount)
+                        { RanEachFrame++; }
+                    Violations += (*Iter)->Violations;
+                }
+                TestOutput << RanEachFrame << " of 64 WorkUnits ran exactly once each frame and " << Violations << " ran before a dependency completed." << endl << endl;
+                TEST(64==RanEachFrame,"ThreadCount::EachRanOncePerFrame");
+                TEST(0==Violations,"ThreadCount::DependenciesRespected");
+            } // \Changing Thread Count
+
+            { // Adaptive Thread Count
+                TestOutput << "Running 8 quick WorkUnits with 4 threads that adapt to a 20 millisecond frame." << endl;
+                stringstream LogCache;
+                FrameScheduler AdaptingScheduler(&LogCache,4);
+                AdaptingScheduler.SetFrameLength(20000);
+                AdaptingScheduler.SetAdaptiveThreadCount(true);
+                AdaptingScheduler.SetMaximumThreadCount(4);
+                TEST(AdaptingScheduler.GetAdaptiveThreadCount() && 1==AdaptingScheduler.GetMinimumThreadCount() && 4==AdaptingScheduler.GetMaximumThreadCount(),"Adaptive::Configured");
+                std::vector<PausesWorkUnit*> Units;
+                for(Whole Counter = 0; Counter<8; ++Counter)
+                {
+                    Units.push_back(new PausesWorkUnit(10,"Adaptive" + ToString(Counter)));
+                    AdaptingScheduler.AddWorkUnitMain(Units.back(), "Adaptive" + ToString(Counter)); // The scheduler deletes these
+                }
+                for(Whole Counter = 0; Counter<MEZZ_FRAMESTOTRACK*4; ++Counter)
+                    { AdaptingScheduler.DoOneFrame(); }
+                TestOutput << "With little work the thread count settled at " << AdaptingScheduler.GetThreadCount() << "." << endl;
+                TEST(1==AdaptingScheduler.GetThreadCount(),"Adaptive::ShedsThreadsWhenIdle");
+
+                TestOutput << "Making each WorkUnit take 6 milliseconds, so 1 thread cannot finish them in a frame." << endl;
+                for(std::vector<PausesWorkUnit*>::iterator Iter = Units.begin(); Iter!=Units.end(); ++Iter)
+                    { (*Iter)->Length = 6000; }
+                Whole GrowingFrames = 0;
+                for(; GrowingFrames<MEZZ_FRAMESTOTRACK && AdaptingScheduler.GetThreadCount()<4; ++GrowingFrames)
+                    { AdaptingScheduler.DoOneFrame(); }
+                TestOutput << "After " << GrowingFrames << " frames there are " << AdaptingScheduler.GetThreadCount() << " threads." << endl;
+                TEST(4==AdaptingScheduler.GetThreadCount(),"Adaptive::AddsThreadsWhenBehind");
+                Whole Changes = 0;
+                for(Whole Counter = 0, Previous = AdaptingScheduler.GetThreadCount(); Counter<MEZZ_FRAMESTOTRACK*2; ++Counter)
+                {
+                    AdaptingScheduler.DoOneFrame();
+                    if(Previous!=AdaptingScheduler.GetThreadCount())
+                        { Changes++; }
+                    Previous = AdaptingScheduler.GetThreadCount();
+                }
+                TestOutput << "The thread count changed " << Changes << " times while the work stayed the same." << endl << endl;
+                TEST(0==Changes,"Adaptive::DoesNotFlap");
+            } // \Adaptive Thread Count
+
+            { // Frame Pipelining
+                TestOutput << "Creating a 5 millisecond tail WorkUnit, a chain of 2 quick pipelined WorkUnits and a pipelined WorkUnit with a cross-frame dependency on the tail." << endl;
+                const Whole PipelineFrames = 20;
+                for(Whole Pipelining = 0; Pipelining<2; ++Pipelining)
+                {
+                    stringstream LogCache;
+                    FrameScheduler PipelineScheduler(&LogCache,2);
+                    PipelineScheduler.SetFrameLength(0);
+                    CountsRunsWorkUnit* Tail = new CountsRunsWorkUnit(5000);
+                    CountsRunsWorkUnit* First = new CountsRunsWorkUnit(100);
+                    CountsRunsWorkUnit* Second = new CountsRunsWorkUnit(100,First,0);
+                    CountsRunsWorkUnit* Follower = new CountsRunsWorkUnit(100,Tail,1);
+                    Second->AddDependency(First);
+                    PipelineScheduler.AddWorkUnitMain(Tail,"Tail"); // The scheduler deletes these
+                    PipelineScheduler.AddWorkUnitMain(First,"First");
+                    PipelineScheduler.AddWorkUnitMain(Second,"Second");
+                    PipelineScheduler.AddWorkUnitMain(Follower,"Follower");
+                    PipelineScheduler.SetWorkUnitPipelined(First);
+                    PipelineScheduler.SetWorkUnitPipelined(Second);
+                    PipelineScheduler.SetWorkUnitPipelined(Follower);
+                    PipelineScheduler.AddCrossFrameDependency(Follower,Tail);
+                    PipelineScheduler.SetFramePipelining(1==Pipelining);
+                    TEST(PipelineScheduler.IsWorkUnitPipelined(First) && !PipelineScheduler.IsWorkUnitPipelined(Tail),"Pipelining::UnitsMarked");
+
+                    for(Whole Frame = 0; Frame<PipelineFrames; ++Frame)
+                        { PipelineScheduler.DoOneFrame(); }
+
+                    TestOutput << (Pipelining ? "With" : "Without") << " pipelining " << PipelineScheduler.GetEarlyStartCount() << " WorkUnits started early in " << PipelineFrames
+                               << " frames. Runs - Tail: " << Tail->Runs << " First: " << First->Runs << " Second: " << Second->Runs << " Follower: " << Follower->Runs << endl;
+                    String Mode(Pipelining ? "Pipelined" : "Serial");
+                    TEST(Int32(PipelineFrames)==Tail->Runs,"Pipelining::" + Mode + "TailRunsEachFrame");
+                    TEST(Int32(PipelineFrames)<=First->Runs && First->Runs<=Int32(PipelineFrames)+1,"Pipelining::" + Mode + "AtMostOneFrameAhead");
+                    TEST(Int32(PipelineFrames)<=Second->Runs && Second->Runs<=First->Runs,"Pipelining::" + Mode + "DependentNotAhead");
+                    TEST(Int32(PipelineFrames)<=Follower->Runs && Follower->Runs<=Tail->Runs+1,"Pipelining::" + Mode + "CrossFrameRespected");
+                    TEST(0==Second->Violations && 0==Follower->Violations,"Pipelining::" + Mode + "NoOrderViolations");
+                    if(Pipelining)
+                        { TEST(0<PipelineScheduler.GetEarlyStartCount(),"Pipelining::StartsEarly"); }
+                    else
+                        { TEST(0==PipelineScheduler.GetEarlyStartCount(),"Pipelining::OffByDefault"); }
+                }
+                TestOutput << endl;
+            } // \Frame Pipelining
+
+            { // Multi-Rate
+                TestOutput << "Creating two WorkUnits that run every other frame, one that runs every fourth frame and one every frame that depends on all of them." << endl;
+                const Whole RateFrames = 20;
+                stringstream LogCache;
+                FrameScheduler RateScheduler(&LogCache,2);
+                RateScheduler.SetFrameLength(0);
+                CountsRunsWorkUnit* EvenOdd1 = new CountsRunsWorkUnit(100);
+                CountsRunsWorkUnit* EvenOdd2 = new CountsRunsWorkUnit(100);
+                CountsRunsWorkUnit* Quarterly = new CountsRunsWorkUnit(100);
+                CountsRunsWorkUnit* Reader = new CountsRunsWorkUnit(100);
+                Reader->AddDependency(EvenOdd1);
+                Reader->AddDependency(EvenOdd2);
+                Reader->AddDependency(Quarterly);
+                RateScheduler.AddWorkUnitMain(EvenOdd1,"EvenOdd1"); // The scheduler deletes these
+                RateScheduler.AddWorkUnitMain(EvenOdd2,"EvenOdd2");
+                RateScheduler.AddWorkUnitMain(Quarterly,"Quarterly");
+                RateScheduler.AddWorkUnitMain(Reader,"Reader");
+                RateScheduler.SetWorkUnitPeriod(EvenOdd1,2);
+                RateScheduler.SetWorkUnitPeriod(EvenOdd2,2);
+                RateScheduler.SetWorkUnitPeriod(Quarterly,4,5);
+                TEST(2==RateScheduler.GetWorkUnitPeriod(EvenOdd1) && 1==RateScheduler.GetWorkUnitPeriod(Reader),"MultiRate::Period");
+                TEST(RateScheduler.GetWorkUnitPhase(EvenOdd1)!=RateScheduler.GetWorkUnitPhase(EvenOdd2),"MultiRate::Staggered");
+                TEST(1==RateScheduler.GetWorkUnitPhase(Quarterly),"MultiRate::ExplicitPhase");
+
+                for(Whole Frame = 0; Frame<RateFrames; ++Frame)
+                    { RateScheduler.DoOneFrame(); }
+
+                TestOutput << dec << "In " << RateFrames << " frames EvenOdd1 ran " << EvenOdd1->Runs << " times, EvenOdd2 " << EvenOdd2->Runs
+                           << ", Quarterly " << Quarterly->Runs << " and Reader " << Reader->Runs << endl;
+                TEST(Int32(RateFrames/2)==EvenOdd1->Runs && Int32(RateFrames/2)==EvenOdd2->Runs,"MultiRate::EveryOtherFrame");
+                TEST(Int32(RateFrames/4)==Quarterly->Runs,"MultiRate::EveryFourthFrame");
+                TEST(Int32(RateFrames)==Reader->Runs,"MultiRate::DependentRunsEachFrame");
+
+                RateScheduler.SetWorkUnitPeriod(EvenOdd1,1);
+                TEST(1==RateScheduler.GetWorkUnitPeriod(EvenOdd1),"MultiRate::Removed");
+                for(Whole Frame = 0; Frame<RateFrames; ++Frame)
+                    { RateScheduler.DoOneFrame(); }
+                Int32 RunsAgain = EvenOdd1->Runs - Int32(RateFrames/2); // The frame after a change may already have been skipped
+                TEST(Int32(RateFrames)-1<=RunsAgain && RunsAgain<=Int32(RateFrames),"MultiRate::EveryFrameAgain");
+                TestOutput << endl;
+            } // \Multi-Rate
+
+            { // Optional WorkUnits
+                TestOutput << "Creating a mandatory, a low priority optional and a high priority optional WorkUnit of 4 milliseconds each in 10 millisecond frames on 1 thread." << endl;
+                const Whole DeadlineFrames = 30;
+                stringstream LogCache;
+                FrameScheduler DeadlineScheduler(&LogCache,1);
+                DeadlineScheduler.SetFrameLength(10000);
+                CountsRunsWorkUnit* Mandatory = new CountsRunsWorkUnit(4000);
+                CountsRunsWorkUnit* LowPriority = new CountsRunsWorkUnit(4000);
+                CountsRunsWorkUnit* HighPriority = new CountsRunsWorkUnit(4000);
+                CountsRunsWorkUnit* Reader = new CountsRunsWorkUnit();
+                Reader->AddDependency(LowPriority);
+                Reader->AddDependency(HighPriority);
+                DeadlineScheduler.AddWorkUnitMain(Mandatory,"Mandatory"); // The scheduler deletes these
+                DeadlineScheduler.AddWorkUnitMain(LowPriority,"LowPriority");
+                DeadlineScheduler.AddWorkUnitMain(HighPriority,"HighPriority");
+                DeadlineScheduler.AddWorkUnitMain(Reader,"Reader");
+                DeadlineScheduler.SetWorkUnitOptional(LowPriority,0);
+                DeadlineScheduler.SetWorkUnitOptional(HighPriority,5);
+                TEST(DeadlineScheduler.IsWorkUnitOptional(LowPriority) && !DeadlineScheduler.IsWorkUnitOptional(Mandatory),"Optional::Marked");
+
+                for(Whole Frame = 0; Frame<DeadlineFrames; ++Frame)
+                    { DeadlineScheduler.DoOneFrame(); }
+
+                TestOutput << dec << "In " << DeadlineFrames << " frames " << DeadlineScheduler.GetShedCount() << " WorkUnits were shed. Runs - Mandatory: " << Mandatory->Runs
+                           << " LowPriority: " << LowPriority->Runs << " HighPriority: " << HighPriority->Runs << " Reader: " << Reader->Runs << endl;
+                TEST(Int32(DeadlineFrames)==Mandatory->Runs && Int32(DeadlineFrames)==Reader->Runs,"Optional::MandatoryRunsEachFrame");
+                TEST(0<DeadlineScheduler.GetShedCount(),"Optional::ShedWhenOverloaded");
+                TEST(LowPriority->Runs<HighPriority->Runs,"Optional::LowestPriorityShedFirst");
+                TEST(1<LowPriority->Runs,"Optional::DeferredNotStarved");
+
+                DeadlineScheduler.SetWorkUnitMandatory(LowPriority);
+                DeadlineScheduler.SetWorkUnitMandatory(HighPriority);
+                Whole ShedBefore = DeadlineScheduler.GetShedCount();
+                for(Whole Frame = 0; Frame<5; ++Frame)
+                    { DeadlineScheduler.DoOneFrame(); }
+                TEST(ShedBefore==DeadlineScheduler.GetShedCount() && !DeadlineScheduler.IsWorkUnitOptional(LowPriority),"Optional::MandatoryNeverShed");
+                TestOutput << endl;
+            } // \Optional WorkUnits
+
+            { // Background WorkUnits
+                TestOutput << "Creating a 1 millisecond WorkUnit and two 1 millisecond background WorkUnits on 2 threads in 20 millisecond frames." << endl;
+                const Whole BackgroundFrames = 10;
+                const MaxInt BackgroundLength = 20000;
+                stringstream LogCache;
+                FrameScheduler BackgroundScheduler(&LogCache,2);
+                BackgroundScheduler.SetFrameLength(0);
+                CountsRunsWorkUnit* FrameWork = new CountsRunsWorkUnit(1000);
+                CountsRunsWorkUnit* Slices1 = new CountsRunsWorkUnit(1000);
+                CountsRunsWorkUnit* Slices2 = new CountsRunsWorkUnit(1000);
+                BackgroundScheduler.AddWorkUnitMain(FrameWork,"FrameWork"); // The scheduler deletes these
+                BackgroundScheduler.AddWorkUnitBackground(Slices1,"Slices1");
+                BackgroundScheduler.AddWorkUnitBackground(Slices2,"Slices2");
+                TEST(2==BackgroundScheduler.GetWorkUnitBackgroundCount(),"Background::Added");
+
+                BackgroundScheduler.DoOneFrame();
+                TEST(0==BackgroundScheduler.GetBackgroundRunCount(),"Background::NoPauseNoRuns");
+
+                BackgroundScheduler.SetFrameLength(BackgroundLength);
+                BackgroundScheduler.DoOneFrame(); // Start the frames below on time
+                MaxInt Start = GetTimeStamp();
+                for(Whole Frame = 0; Frame<BackgroundFrames; ++Frame)
+                    { BackgroundScheduler.DoOneFrame(); }
+                MaxInt AverageFrame = (GetTimeStamp()-Start)/MaxInt(BackgroundFrames);
+
+                TestOutput << dec << "Background WorkUnits ran " << BackgroundScheduler.GetBackgroundRunCount() << " times, Slices1: " << Slices1->Runs << " Slices2: " << Slices2->Runs
+                           << ", and frames averaged " << AverageFrame << " microseconds." << endl;
+                TEST(Int32(BackgroundFrames)+2==FrameWork->Runs,"Background::FrameWorkRuns");
+                TEST(Int32(BackgroundFrames)<Slices1->Runs && Int32(BackgroundFrames)<Slices2->Runs,"Background::SoaksUpPauses");
+                TEST(Slices1->Runs+Slices2->Runs==BackgroundScheduler.GetBackgroundRunCount(),"Background::Counted");
+                TEST(AverageFrame<BackgroundLength+1000,"Background::FramesStillOnTime");
+
+                BackgroundScheduler.RemoveWorkUnitBackground(Slices2);
+                Int32 Slices2Runs = Slices2->Runs;
+                BackgroundScheduler.DoOneFrame();
+                TEST(1==BackgroundScheduler.GetWorkUnitBackgroundCount() && Slices2Runs==Slices2->Runs,"Background::Removed");
+                delete Slices2;
+                TestOutput << endl;
+            } // \Background WorkUnits
+
+            { // Thread Affinity
+                #ifdef __linux__
+                cpu_set_t StartingSet;
+                bool StartingSetRead = 0==sched_getaffinity(0, sizeof(StartingSet), &StartingSet);
+                #endif
+                std::vector<LogicalCPU> Topology = GetCPUTopology();
+                TestOutput << dec << "Found " << Topology.size() << " online logical processors:" << endl;
+                std::vector<Whole> TopologyIDs;
+                for(std::vector<LogicalCPU>::const_iterator Iter = Topology.begin(); Iter!=Topology.end(); ++Iter)
+                {
+                    TestOutput << "  CPU " << Iter->ID << " is on core " << Iter->Core << " of package " << Iter->Package << endl;
+                    TopologyIDs.push_back(Iter->ID);
+                }
+                TEST(!Topology.empty(),"Affinity::TopologyFound");
+
+                stringstream LogCache;
+                FrameScheduler PinnedScheduler(&LogCache,4);
+                std::vector<PausesWorkUnit*> Units;
+                for(Whole Counter = 0; Counter<8; ++Counter)
+                {
+                    Units.push_back(new PausesWorkUnit(10,"Pinned" + ToString(Counter)));
+                    PinnedScheduler.AddWorkUnitMain(Units.back(), "Pinned" + ToString(Counter)); // The scheduler deletes these
+                }
+                TEST(NoAffinity==PinnedScheduler.GetThreadAffinity() && PinnedScheduler.GetThreadAffinityCPUs().empty(),"Affinity::DefaultsToNone");
+
+                const ThreadAffinityPolicy Policies[] = { CompactAffinity, ScatterAffinity, PhysicalCoresFirstAffinity };
+                const String PolicyNames[] = { "Compact", "Scatter", "PhysicalCoresFirst" };
+                for(Whole Counter = 0; Counter<3; ++Counter)
+                {
+                    PinnedScheduler.SetThreadAffinity(Policies[Counter]);
+                    std::vector<Whole> Order = PinnedScheduler.GetThreadAffinityCPUs();
+                    TestOutput << PolicyNames[Counter] << " order:";
+                    for(std::vector<Whole>::const_iterator Iter = Order.begin(); Iter!=Order.end(); ++Iter)
+                        { TestOutput << " " << *Iter; }
+                    TestOutput << endl;
+                    TEST(Policies[Counter]==PinnedScheduler.GetThreadAffinity(),"Affinity::" + PolicyNames[Counter] + "Set");
+                    std::sort(Order.begin(),Order.end());
+                    TEST(Order==TopologyIDs,"Affinity::" + PolicyNames[Counter] + "UsesEveryCPU");
+                    for(Whole Frame = 0; Frame<5; ++Frame)
+                        { PinnedScheduler.DoOneFrame(); }
+                }
+
+                std::vector<Whole> Explicit(1,TopologyIDs.back());
+                PinnedScheduler.SetThreadAffinity(Explicit);
+                TEST(ExplicitAffinity==PinnedScheduler.GetThreadAffinity() && Explicit==PinnedScheduler.GetThreadAffinityCPUs(),"Affinity::ExplicitSet");
+                for(Whole Frame = 0; Frame<5; ++Frame)
+                    { PinnedScheduler.DoOneFrame(); }
+
+                TestOutput << "Pinning every thread to the first logical processor, so every thread's resources should move to its node." << endl;
+                std::vector<Whole> First(1,Topology.front().ID);
+                PinnedScheduler.SetThreadAffinity(First);
+                PinnedScheduler.SetWorkStealing(true);
+                std::vector<RecordsNodeWorkUnit*> Recorders;
+                for(Whole Counter = 0; Counter<8; ++Counter)
+                {
+                    Recorders.push_back(new RecordsNodeWorkUnit);
+                    PinnedScheduler.AddWorkUnitMain(Recorders.back(), "Recorder" + ToString(Counter)); // The scheduler deletes these
+                }
+                for(Whole Frame = 0; Frame<5; ++Frame)
+                    { PinnedScheduler.DoOneFrame(); }
+                Whole Placed = 0;
+                for(std::vector<RecordsNodeWorkUnit*>::iterator Iter = Recorders.begin(); Iter!=Recorders.end(); ++Iter)
+                {
+                    if(Int32(Topology.front().Node)==(*Iter)->Node)
+                        { Placed++; }
+                }
+                TestOutput << Placed << " of " << Recorders.size() << " WorkUnits last ran with resources on node " << Topology.front().Node << "." << endl;
+                TEST(Recorders.size()==Placed,"Affinity::ResourcesPlacedOnNode");
+                TEST(Int32(Topology.front().Node)==PinnedScheduler.GetThreadResource()->GetNumaNode(),"Affinity::MainResourcesPlacedOnNode");
+                PinnedScheduler.SetWorkStealing(false);
+
+                TEST(0==PinnedScheduler.GetThreadAffinityFailureCount(),"Affinity::NoFailures");
+                std::vector<Whole> Impossible(1,Whole(1)<<20);
+                PinnedScheduler.SetThreadAffinity(Impossible);
+                PinnedScheduler.DoOneFrame();
+                TestOutput << "Pinning to logical processor " << Impossible[0] << " failed " << PinnedScheduler.GetThreadAffinityFailureCount() << " times in one frame." << endl;
+                #if defined(_MEZZ_THREAD_WIN32_) || defined(__linux__)
+                TEST(0<PinnedScheduler.GetThreadAffinityFailureCount(),"Affinity::FailureCounted");
+                #endif
+
+                PinnedScheduler.SetThreadAffinity(NoAffinity);
+                TEST(NoAffinity==PinnedScheduler.GetThreadAffinity() && PinnedScheduler.GetThreadAffinityCPUs().empty(),"Affinity::Cleared");
+                PinnedScheduler.RunAllMonopolies();
+                PinnedScheduler.CreateThreads();
+                PinnedScheduler.RunMainThreadWork();
+                PinnedScheduler.JoinAllThreads();
+                Whole Ran = 0;
+                for(std::vector<PausesWorkUnit*>::iterator Iter = Units.begin(); Iter!=Units.end(); ++Iter)
+                {
+                    if(Complete==(*Iter)->GetRunningState())
+                        { Ran++; }
+                }
+                TestOutput << Ran << " of " << Units.size() << " WorkUnits completed in the last frame." << endl << endl;
+                TEST(Units.size()==Ran,"Affinity::FramesStillRun");
+                PinnedScheduler.ResetAllWorkUnits();
+                this_thread::clear_affinity();
+                #ifdef __linux__
+                cpu_set_t ClearedSet;
+                TEST(StartingSetRead && 0==sched_getaffinity(0, sizeof(ClearedSet), &ClearedSet) && CPU_EQUAL(&StartingSet,&ClearedSet),"Affinity::ClearRestoresStartingSet");
+                #endif
+            } // \Thread Affinity
+
+            { // Frame Pacing
+                stringstream LogCache;
+                FrameScheduler PacedScheduler(&LogCache,1);
+                const MaxInt PacedLength = 5000;
+                const Whole PacedFrames = 60;
+                const Whole WarmUpFrames = 5;
+                PacedScheduler.SetFrameLength(PacedLength);
+                TestOutput << "Running " << PacedFrames << " empty frames of " << PacedLength << " microseconds to measure when each starts." << endl;
+
+                std::vector<MaxInt> Deviations;
+                MaxInt LastStart = GetTimeStamp();
+                for(Whole Frame = 0; Frame<PacedFrames; ++Frame)
+                {
+                    PacedScheduler.DoOneFrame();
+                    MaxInt Start = GetTimeStamp();
+                    MaxInt Deviation = Start-LastStart-PacedLength;
+                    if(Deviation<0)
+                        { Deviation = -Deviation; }
+                    if(WarmUpFrames<=Frame)
+                        { Deviations.push_back(Deviation); }
+                    LastStart = Start;
+                }
+                std::sort(Deviations.begin(),Deviations.end());
+                MaxInt MedianDeviation = Deviations[Deviations.size()/2]; // Other processes preempting this can cause a few outliers
+                MaxInt WorstDeviation = Deviations.back();
+                TestOutput << dec << "Frames started typically " << MedianDeviation << " and at worst " << WorstDeviation << " microseconds off, the pacing margin settled at "
+                           << PacedScheduler.GetFramePacingMargin() << " microseconds." << endl;
+                TEST_WARN(MedianDeviation<100,"Pacing::TypicalJitter");
+                TEST_WARN(WorstDeviation<100,"Pacing::WorstJitter");
+                TEST(PacedScheduler.GetFramePacingMargin()<=MEZZ_MAXPACINGMARGIN,"Pacing::MarginBounded");
+
+                TEST(MEZZ_MAXFRAMEWAIT==PacedScheduler.GetMaximumFrameWait(),"Pacing::DefaultMaximumWait");
+                PacedScheduler.SetFrameLength(2000000);
+                PacedScheduler.SetMaximumFrameWait(20000);
+                MaxInt LongFrameStart = GetTimeStamp();
+                PacedScheduler.DoOneFrame();
+                MaxInt LongFrameLength = GetTimeStamp()-LongFrameStart;
+                TestOutput << "A 2 second frame limited to a 20 millisecond wait took " << LongFrameLength << " microseconds." << endl;
+                TEST(LongFrameLength<500000,"Pacing::MaximumWaitRespected");
+
+                PacedScheduler.SetFrameLength(PacedLength);
+                PacedScheduler.SetMaximumFrameWait(MEZZ_MAXFRAMEWAIT);
+                MaxInt LongestAfter = 0;
+                LastStart = GetTimeStamp();
+                for(Whole Frame = 0; Frame<3; ++Frame)
+                {
+                    PacedScheduler.DoOneFrame();
+                    MaxInt Start = GetTimeStamp();
+                    if(LongestAfter<Start-LastStart)
+                        { LongestAfter = Start-LastStart; }
+                    LastStart = Start;
+                }
+                TestOutput << "The longest of the next 3 frames of " << PacedLength << " microseconds took " << LongestAfter << " microseconds." << endl << endl;
+                TEST(LongestAfter<PacedLength*10,"Pacing::ShortenedWaitNotRepaid");
+            } // \Frame Pacing
+
             {
                 stringstream LogCache;
                 FrameScheduler Scheduler1(&LogCache);
@@ -1123,7 +1654,7 @@ class frameschedulertests : public UnitTestGroup
                 MaxInt PauseLength = Scheduler1.GetPauseTimeRollingAverage()[Scheduler1.GetPauseTimeRollingAverage().RecordCapacity()-1];
                 TestOutput << "Without knowing the performance of this machine ahead of time, knowing the size of the pause is impossible, how it can be tested for sane values, it is: "
                      << PauseLength<< "  microseconds." << endl;
-                TEST( (0<=PauseLength) && (PauseLength<=FrameLength+1),"LastPauseData" );
+                TEST( (0<=PauseLength) && (PauseLength<FrameLength+200),"LastPauseData" ); // Paced frames land on either side of the target
 
             }
 
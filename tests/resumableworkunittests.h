@@ -0,0 +1,237 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _resumableworkunittests_h
+#define _resumableworkunittests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+#include "asyncworkunittests.h"
+
+/// @file
+/// @brief Tests of WorkUnits that suspend while waiting and are continued later.
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief A WorkUnit that waits on asynchronous work, then another WorkUnit, then a short time.
+class StepsWorkUnit : public ResumableWorkUnit
+{
+    public:
+        /// @brief Asynchronous work this starts and waits on.
+        SleepingAsyncWorkUnit Loader;
+
+        /// @brief Another WorkUnit to wait on, if not 0.
+        iWorkUnit* Awaited;
+
+        /// @brief How long to wait at the last step in microseconds.
+        Whole Delay;
+
+        /// @brief How many steps have been reached this frame.
+        Int32 Steps;
+
+        /// @brief How many times DoWork has been called, more than once a frame when it suspends.
+        Int32 Entries;
+
+        /// @brief Create one
+        /// @param LoadLength How long the asynchronous work takes in microseconds.
+        /// @param Awaited_ Another WorkUnit to wait on, if not 0.
+        /// @param Delay_ How long to wait at the last step in microseconds.
+        StepsWorkUnit(Whole LoadLength, iWorkUnit* Awaited_, Whole Delay_)
+            : Loader(LoadLength), Awaited(Awaited_), Delay(Delay_), Steps(0), Entries(0)
+            { }
+
+        /// @brief Take each step, waiting between them.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+        {
+            Entries++;
+            switch(ResumePoint)
+            {
+                case 0:
+                    Steps = 1;
+                    Loader.Begin();
+                    if(AwaitAsynchronousWork(Loader,1))
+                        { return; }
+                    // Falls through
+                case 1:
+                    Steps = 2;
+                    if(Awaited && AwaitWorkUnit(*Awaited,2))
+                        { return; }
+                    // Falls through
+                case 2:
+                    Steps = 3;
+                    if(AwaitTime(Mezzanine::GetTimeStamp()+Delay,3))
+                        { return; }
+                    // Falls through
+                case 3:
+                    Steps = 4;
+            }
+        }
+};
+
+/// @brief A WorkUnit that records how far a StepsWorkUnit had gotten when this ran.
+class StepsObserverWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief The WorkUnit to observe.
+        StepsWorkUnit* Observed;
+
+        /// @brief How many steps Observed had reached the last time this ran.
+        Int32 StepsSeen;
+
+        /// @brief Create one
+        /// @param Observed_ The WorkUnit to observe.
+        StepsObserverWorkUnit(StepsWorkUnit* Observed_) : Observed(Observed_), StepsSeen(-1)
+            { }
+
+        /// @brief Record the steps.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+            { StepsSeen = Observed->Steps; }
+};
+
+/// @brief A WorkUnit that only waits a while each frame.
+class DelayWorkUnit : public ResumableWorkUnit
+{
+    public:
+        /// @brief How long to wait in microseconds.
+        Whole Delay;
+
+        /// @brief Create one
+        /// @param Delay_ How long to wait in microseconds.
+        DelayWorkUnit(Whole Delay_) : Delay(Delay_)
+            { }
+
+        /// @brief Wait once.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+        {
+            if(0==ResumePoint && AwaitTime(Mezzanine::GetTimeStamp()+Delay,1))
+                { return; }
+        }
+};
+
+/// @brief Tests for the ResumableWorkUnit
+class resumableworkunittests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "ResumableWorkUnit"
+        virtual String Name()
+            { return String("ResumableWorkUnit"); }
+
+        /// @brief Test waiting with and without a scheduler.
+        void RunAutomaticTests()
+        {
+            {
+                TestOutput << "Running a ResumableWorkUnit without a scheduler, so each wait blocks." << endl;
+                StepsWorkUnit Blocking(10000,0,5000);
+                DefaultThreadSpecificStorage::Type Storage(0);
+                MaxInt Start = GetTimeStamp();
+                Blocking(Storage);
+                MaxInt Length = GetTimeStamp()-Start;
+                TestOutput << "It took " << Length << " microseconds and DoWork was entered " << Blocking.Entries << " times." << endl;
+                TEST(4==Blocking.Steps && 1==Blocking.Entries,"BlocksWithoutScheduler");
+                TEST(Complete==Blocking.Loader.IsWorkDone() && 15000<=Length,"BlockingWaitsEachStep");
+                TEST(Complete==Blocking.GetRunningState() && !Blocking.IsSuspended(),"CompletesWithoutScheduler");
+            }
+
+            {
+                TestOutput << "Running a ResumableWorkUnit waiting on 10ms of asynchronous work, a 20ms asynchronous WorkUnit and 5ms "
+                           << "in a frame with 1 thread, alongside an independent WorkUnit and one depending on it." << endl;
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,1);
+                Scheduler.SetFrameLength(0);
+                SleepingAsyncWorkUnit* Async = new SleepingAsyncWorkUnit(20000);
+                StepsWorkUnit* Steps = new StepsWorkUnit(10000,Async,5000);
+                StepsObserverWorkUnit* Independent = new StepsObserverWorkUnit(Steps);
+                StepsObserverWorkUnit* Dependent = new StepsObserverWorkUnit(Steps);
+                Dependent->AddDependency(Steps);
+                Scheduler.AddWorkUnitMain(Async,"Async"); // The scheduler deletes these
+                Scheduler.AddWorkUnitMain(Steps,"Steps");
+                Scheduler.AddWorkUnitMain(Independent,"Independent");
+                Scheduler.AddWorkUnitMain(Dependent,"Dependent");
+
+                Async->Begin();
+                MaxInt Start = GetTimeStamp();
+                Scheduler.DoOneFrame();
+                MaxInt Length = GetTimeStamp()-Start;
+                TestOutput << "The frame took " << Length << " microseconds, DoWork was entered " << Steps->Entries
+                           << " times and the independent WorkUnit saw " << Independent->StepsSeen << " steps." << endl;
+                TEST(4==Steps->Steps,"AllStepsInFrame");
+                TEST(1<Steps->Entries,"SuspendedAndResumed");
+                TEST(4>Independent->StepsSeen,"OtherWorkWhileSuspended");
+                TEST(4==Dependent->StepsSeen,"DependentAfterLastStep");
+                TEST(Complete==Async->IsWorkDone() && 20000<=Length,"FrameWaitsForResumedWork");
+                TEST(!Steps->IsSuspended(),"NotSuspendedAfterFrame");
+
+                TestOutput << "Running a second frame where the asynchronous work is already done." << endl;
+                Whole EntriesBefore = Steps->Entries;
+                Scheduler.DoOneFrame();
+                TEST(4==Steps->Steps && 4==Dependent->StepsSeen,"SecondFrameCompletes");
+                TEST(EntriesBefore<Whole(Steps->Entries),"SecondFrameRan");
+                TestOutput << endl;
+            }
+
+            {
+                TestOutput << "Running a frame with 2 threads where the only work left is a WorkUnit waiting 20ms." << endl;
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,2);
+                Scheduler.SetFrameLength(0);
+                Scheduler.AddWorkUnitMain(new DelayWorkUnit(20000),"Delay");
+                Int32 ParksBefore = Scheduler.GetIdleParkCount();
+                MaxInt Start = GetTimeStamp();
+                Scheduler.DoOneFrame();
+                MaxInt Length = GetTimeStamp()-Start;
+                Int32 Parks = Scheduler.GetIdleParkCount()-ParksBefore;
+                TestOutput << "The frame took " << Length << " microseconds and idle threads parked " << Parks << " times." << endl;
+                TEST(20000<=Length,"FrameWaitsForDelay");
+                TEST(0<Parks,"ParksUntilDue");
+                TestOutput << endl;
+            }
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
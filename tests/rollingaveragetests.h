@@ -121,6 +121,13 @@ class rollingaveragetests : public UnitTestGroup
             TEST(11.0 == RollingB2[0], "BufferedOldestEntry");
             TestOutput << "WeightedRollingAverage oldest inserted value, should be 20: " << RollingW2[0] << endl;
             TEST(20.0 == RollingW2[0], "WieghtOldestEntry");
+
+            TestOutput << "Creating a WeightedRollingAverage doing its math with Mezzanine::Whole and inserting 100 a hundred times." << endl;
+            Mezzanine::WeightedRollingAverage<Mezzanine::Whole,Mezzanine::Whole> RollingI(10);
+            for(Mezzanine::Whole Counter=0; Counter<100; Counter++)
+                { RollingI.Insert(100); }
+            TestOutput << "WeightedRollingAverage Result, should be close to 100: " << RollingI.GetAverage() << endl;
+            TEST(RollingI.GetAverage()>90 && RollingI.GetAverage()<=100, "WeightedIntegerMath");
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.
@@ -0,0 +1,254 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _threadteamtests_h
+#define _threadteamtests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+
+/// @file
+/// @brief Tests of Monopolies running with a ThreadTeam and their place in the order of WorkUnits.
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief How many normal WorkUnits in the 'threadteam' test are currently running.
+Int32 TeamTestRunning = 0;
+
+/// @brief Incremented as each WorkUnit in the 'threadteam' test starts, so the order they ran in can be checked.
+Int32 TeamTestSequence = 0;
+
+/// @brief Counts how many times each index of a ParallelFor was visited.
+void TeamTestCountRange(void* Argument, const Whole& Begin, const Whole& End, DefaultThreadSpecificStorage::Type&)
+{
+    vector<Int32>& Visits = *((vector<Int32>*)Argument);
+    for(Whole Index = Begin; Index<End; ++Index)
+        { AtomicAdd(&Visits[Index],1); }
+}
+
+/// @brief Each member publishes a value, waits for the others, then checks it can see every value.
+void TeamTestPublishThenRead(void* Argument, const Whole& Member, ThreadTeam& Team, DefaultThreadSpecificStorage::Type&)
+{
+    vector<Int32>& Published = *((vector<Int32>*)Argument);
+    AtomicAdd(&Published[Member],Int32(Member)+1);
+    Team.Wait();
+    for(Whole Other = 0; Other<Team.GetSize(); ++Other)
+    {
+        if(Int32(Other)+1!=AtomicAdd(&Published[Other],0))
+            { AtomicAdd(&Published[Team.GetSize()],1); } // The last entry counts values seen too early
+    }
+}
+
+/// @brief A normal WorkUnit that records when it started and whether anything else ran alongside a Monopoly.
+class TeamTestWorkUnit : public DefaultWorkUnit
+{
+    public:
+        /// @brief The value of TeamTestSequence when this last started.
+        Int32 Started;
+
+        /// @brief Constructor
+        TeamTestWorkUnit() : Started(-1)
+            { }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~TeamTestWorkUnit()
+            { }
+
+        /// @brief Record the start then stay busy briefly.
+        /// @param CurrentThreadStorage Ignored.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type&)
+        {
+            AtomicAdd(&TeamTestRunning,1);
+            Started = AtomicAdd(&TeamTestSequence,1);
+            Mezzanine::Threading::this_thread::sleep_for(500);
+            AtomicAdd(&TeamTestRunning,-1);
+        }
+};
+
+/// @brief A Monopoly that puts its team to work and checks nothing else runs alongside it.
+class TeamTestMonopoly : public MonopolyWorkUnit
+{
+    public:
+        /// @brief The value of TeamTestSequence when this last started.
+        Int32 Started;
+
+        /// @brief The team size seen by the last run.
+        Whole TeamSize;
+
+        /// @brief How many runs found a normal WorkUnit running.
+        Int32 Overlaps;
+
+        /// @brief How many indexes were visited other than exactly once, across all runs.
+        Int32 BadVisits;
+
+        /// @brief How many values members saw before the team's barrier made them visible, across all runs.
+        Int32 EarlyReads;
+
+        /// @brief How many times this has run.
+        Int32 Runs;
+
+        /// @brief Constructor
+        TeamTestMonopoly() : Started(-1), TeamSize(0), Overlaps(0), BadVisits(0), EarlyReads(0), Runs(0)
+            { }
+
+        /// @brief Empty Virtual Deconstructor
+        virtual ~TeamTestMonopoly()
+            { }
+
+        /// @brief This ignores the hint and uses the team it is given.
+        virtual void UseThreads(const Whole&)
+            { }
+
+        /// @brief The size of the team last used.
+        /// @return A Whole
+        virtual Whole UsingThreadCount()
+            { return TeamSize; }
+
+        /// @brief Run a ParallelFor and a function that uses the team's barrier.
+        /// @param CurrentThreadStorage Used to find the team.
+        virtual void DoWork(DefaultThreadSpecificStorage::Type& CurrentThreadStorage)
+        {
+            Started = AtomicAdd(&TeamTestSequence,1);
+            if(AtomicAdd(&TeamTestRunning,0))
+                { Overlaps++; }
+            ThreadTeam& Team = CurrentThreadStorage.GetFrameScheduler()->GetThreadTeam();
+            TeamSize = Team.GetSize();
+
+            vector<Int32> Visits(1000,0);
+            Team.ParallelFor(0, Visits.size(), TeamTestCountRange, &Visits, 16);
+            for(vector<Int32>::iterator Iter = Visits.begin(); Iter!=Visits.end(); ++Iter)
+            {
+                if(1!=*Iter)
+                    { BadVisits++; }
+            }
+
+            vector<Int32> Published(TeamSize+1,0);
+            Team.Run(TeamTestPublishThenRead, &Published);
+            EarlyReads += Published[TeamSize];
+
+            if(AtomicAdd(&TeamTestRunning,0))
+                { Overlaps++; }
+            Runs++;
+        }
+};
+
+/// @brief Tests for the ThreadTeam class and Monopolies in the DAG
+class threadteamtests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "ThreadTeam"
+        virtual String Name()
+            { return String("ThreadTeam"); }
+
+        /// @brief Test the team outside of a frame, then Monopolies leading a team of every thread and waiting on dependencies.
+        void RunAutomaticTests()
+        {
+            TestOutput << dec << "Using a team outside of a frame, it should only have the calling thread." << endl;
+            {
+                ThreadTeam Lone;
+                ThreadSpecificStorage Storage(0);
+                vector<Int32> Visits(100,0);
+                Lone.ParallelFor(0, Visits.size(), TeamTestCountRange, &Visits);
+                TEST(0==Visits[0],"NothingRunsWithoutMonopoly");
+                Lone.Assemble(Storage);
+                Lone.ParallelFor(0, Visits.size(), TeamTestCountRange, &Visits, 7);
+                Lone.Dismiss();
+                TEST(1==Lone.GetSize() && 1==*std::min_element(Visits.begin(),Visits.end()) && 1==*std::max_element(Visits.begin(),Visits.end()),"AloneVisitsEachIndexOnce");
+            }
+
+            const Whole Frames = 10;
+            TestOutput << "Running " << Frames << " frames on 4 threads with a Monopoly R without dependencies, and main WorkUnits A, B and C" << endl
+                       << "with Monopoly M depending on A and B, and C depending on M." << endl;
+            {
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,4);
+                Scheduler.SetFrameLength(0);
+                TeamTestMonopoly* R = new TeamTestMonopoly;
+                TeamTestMonopoly* M = new TeamTestMonopoly;
+                TeamTestWorkUnit* A = new TeamTestWorkUnit;
+                TeamTestWorkUnit* B = new TeamTestWorkUnit;
+                TeamTestWorkUnit* C = new TeamTestWorkUnit;
+                M->AddDependency(A);
+                M->AddDependency(B);
+                C->AddDependency(M);
+                Scheduler.AddWorkUnitMonopoly(R,"R"); // The scheduler deletes these
+                Scheduler.AddWorkUnitMonopoly(M,"M");
+                Scheduler.AddWorkUnitMain(A,"A");
+                Scheduler.AddWorkUnitMain(B,"B");
+                Scheduler.AddWorkUnitMain(C,"C");
+                Scheduler.SortWorkUnitsAll();
+
+                bool Ordered = true;
+                for(Whole Frame = 0; Frame<Frames; ++Frame)
+                {
+                    TeamTestSequence = 0;
+                    Scheduler.DoOneFrame();
+                    Ordered = Ordered && 0==R->Started && A->Started<M->Started && B->Started<M->Started && M->Started<C->Started;
+                }
+                TestOutput << "R ran " << R->Runs << " times and M " << M->Runs << " times with teams of " << R->TeamSize << " and " << M->TeamSize << " threads." << endl
+                           << "In the last frame they started in this order - R: " << R->Started << " A: " << A->Started << " B: " << B->Started
+                           << " M: " << M->Started << " C: " << C->Started << endl;
+                TEST(Int32(Frames)==R->Runs && Int32(Frames)==M->Runs,"MonopoliesRunEachFrame");
+                TEST(4==R->TeamSize && 4==M->TeamSize,"TeamHasEveryThread");
+                TEST(Ordered,"MonopoliesKeepDependencyOrder");
+                TEST(0==R->Overlaps && 0==M->Overlaps,"NothingRunsAlongsideMonopoly");
+                TEST(0==R->BadVisits && 0==M->BadVisits,"ParallelForVisitsEachIndexOnce");
+                TEST(0==R->EarlyReads && 0==M->EarlyReads,"TeamWaitSynchronizes");
+
+                TestOutput << "Running R alone before the frame, the frame should not run it again." << endl;
+                TeamTestSequence = 0;
+                Scheduler.RunAllMonopolies();
+                Scheduler.DoOneFrame();
+                TEST(Int32(Frames)+1==R->Runs && Int32(Frames)+1==M->Runs && 1==R->TeamSize,"RunAllMonopoliesRunsOnceAlone");
+                TEST(4==M->TeamSize,"DependentMonopolyStillHasTeam");
+            }
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return returns true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
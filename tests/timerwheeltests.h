@@ -0,0 +1,276 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _timerwheeltests_h
+#define _timerwheeltests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+
+/// @file
+/// @brief Tests of the hierarchical timer wheel and the timers a FrameScheduler runs with it.
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief What one timer in the 'timerwheel' tests expects and what happened to it.
+struct TimerRecord
+{
+    /// @brief The earliest timestamp it may run at.
+    MaxInt Expected;
+    /// @brief The timestamp it last ran at, 0 if it has not.
+    MaxInt RanAt;
+    /// @brief How many times it ran.
+    Int32 Runs;
+
+    /// @brief Create one that has not run.
+    /// @param Expected_ The earliest timestamp it may run at.
+    explicit TimerRecord(MaxInt Expected_ = 0) : Expected(Expected_), RanAt(0), Runs(0)
+        { }
+};
+
+/// @brief The timestamp the TimerWheel tests pretend it is, so they do not depend on how fast they run.
+MaxInt TimerTestNow = 0;
+
+/// @brief Records the time a timer ran at, the Argument is a TimerRecord.
+void RecordTimer(void* Record, DefaultThreadSpecificStorage::Type&)
+{
+    TimerRecord& Recording = *((TimerRecord*)Record);
+    Recording.RanAt = TimerTestNow ? TimerTestNow : GetTimeStamp();
+    AtomicAdd(&Recording.Runs,1);
+}
+
+/// @brief Advance a wheel to a time and run what expired.
+/// @param Wheel The wheel to advance.
+/// @param Now What time it is.
+/// @return How many timers expired.
+Whole AdvanceTimerTest(TimerWheel& Wheel, MaxInt Now)
+{
+    static DefaultThreadSpecificStorage::Type Storage(0);
+    vector<TimerWheel::ExpiredTimer> Expired;
+    TimerTestNow = Now;
+    Wheel.Advance(Now,Expired);
+    for(vector<TimerWheel::ExpiredTimer>::iterator Iter = Expired.begin(); Iter!=Expired.end(); ++Iter)
+        { Iter->Function(Iter->Argument,Storage); }
+    return Expired.size();
+}
+
+/// @brief Tests for the TimerWheel and FrameScheduler timers
+class timerwheeltests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "TimerWheel"
+        virtual String Name()
+            { return String("TimerWheel"); }
+
+        /// @brief Test timers expire on time, once and not when cancelled.
+        void RunAutomaticTests()
+        {
+            const MaxInt Tick = MEZZ_TIMERRESOLUTION;
+            const MaxInt Start = 1000000*Tick+Tick/2; // Not on a tick boundary or at 0
+
+            {
+                TestOutput << "Adding 3000 timers spread from now to past the end of the timer wheel and advancing one tick at a time." << endl;
+                TimerWheel Wheel(Start);
+                vector<TimerRecord> Records;
+                Records.reserve(3000);
+                vector<TimerHandle> Handles;
+                MaxInt Farthest = 0;
+                for(Whole Count = 0; Count<3000; ++Count)
+                {
+                    MaxInt Delay = (MaxInt(Count)*Count*Count*7919)%(MaxInt(1)<<26) * Tick / 64; // Spread over every level, some beyond
+                    if(Count<10)
+                        { Delay = MaxInt(Count)*Tick/3; } // Some on this tick and the next few
+                    Records.push_back(TimerRecord(Start+Delay));
+                    Handles.push_back(Wheel.Add(RecordTimer,&Records.back(),Start+Delay));
+                    if(Start+Delay>Farthest)
+                        { Farthest = Start+Delay; }
+                }
+                TEST(3000==Wheel.GetCount(),"CountsAdded");
+
+                Whole Cancelled = 0;
+                bool CancelWorked = true;
+                for(Whole Count = 11; Count<3000; Count+=3)
+                {
+                    CancelWorked = Wheel.Cancel(Handles[Count]) && !Wheel.IsWaiting(Handles[Count]) && CancelWorked;
+                    CancelWorked = !Wheel.Cancel(Handles[Count]) && CancelWorked; // Only once
+                    Records[Count].Expected = -1;
+                    Cancelled++;
+                }
+                TEST(CancelWorked && 3000-Cancelled==Wheel.GetCount(),"CancelRemoves");
+
+                Whole Steps = 0;
+                bool CheckTimeRight = true;
+                for(MaxInt Now = Start; Now<=Farthest+Tick; Now+=Tick, ++Steps)
+                {
+                    MaxInt NextCheck = Wheel.GetNextCheckTime();
+                    if(NextCheck>Now+Tick)
+                    {
+                        CheckTimeRight = CheckTimeRight && 0==AdvanceTimerTest(Wheel,NextCheck-1); // Nothing should expire before it says
+                        Now = (NextCheck/Tick)*Tick-Tick+Tick/2;
+                        continue;
+                    }
+                    AdvanceTimerTest(Wheel,Now);
+                }
+
+                Whole Early = 0, Late = 0, Missed = 0, Extra = 0;
+                for(Whole Count = 0; Count<Records.size(); ++Count)
+                {
+                    TimerRecord& Record = Records[Count];
+                    if(-1==Record.Expected)
+                    {
+                        if(Record.Runs)
+                            { Extra++; }
+                        continue;
+                    }
+                    if(0==Record.Runs)
+                        { Missed++; }
+                    else if(1<Record.Runs)
+                        { Extra++; }
+                    else if(Record.RanAt<Record.Expected)
+                        { Early++; }
+                    else if(Record.RanAt>=Record.Expected+2*Tick)
+                        { Late++; }
+                }
+                TestOutput << "Took " << Steps << " steps, " << dec << Missed << " missed, " << Extra << " extra, " << Early << " early and "
+                           << Late << " late." << endl;
+                TEST(0==Missed && 0==Extra,"EachExpiresOnce");
+                TEST(0==Early,"NoneEarly");
+                TEST(0==Late,"NoneLate");
+                TEST(CheckTimeRight,"NextCheckTimeNotLate");
+                TEST(0==Wheel.GetCount(),"EmptyAfterExpiring");
+            }
+
+            {
+                TestOutput << "Checking periodic timers and reused handles." << endl;
+                MaxInt Now = Start-Tick/2; // On a tick boundary so expiries are not rounded up
+                TimerWheel Wheel(Now);
+                TimerRecord Periodic;
+                TimerHandle PeriodicHandle = Wheel.Add(RecordTimer,&Periodic,Now+5*Tick,5*Tick);
+                for(Whole Count = 0; Count<50; ++Count)
+                    { AdvanceTimerTest(Wheel,Now+=Tick); }
+                TEST(10==Periodic.Runs,"PeriodicRepeats");
+
+                AdvanceTimerTest(Wheel,Now+=50*Tick);
+                TEST(11==Periodic.Runs,"PeriodicSkipsMissed");
+                TEST(Wheel.IsWaiting(PeriodicHandle) && 1==Wheel.GetCount(),"PeriodicStaysWaiting");
+                TEST(Wheel.Cancel(PeriodicHandle),"PeriodicCancels");
+                AdvanceTimerTest(Wheel,Now+=50*Tick);
+                TEST(11==Periodic.Runs,"CancelledPeriodicStops");
+
+                TimerRecord Once;
+                TimerHandle OnceHandle = Wheel.Add(RecordTimer,&Once,Now+Tick);
+                AdvanceTimerTest(Wheel,Now+=2*Tick);
+                TimerRecord Reusing;
+                TimerHandle ReusingHandle = Wheel.Add(RecordTimer,&Reusing,Now+Tick);
+                TEST(1==Once.Runs && OnceHandle!=ReusingHandle && !Wheel.IsWaiting(OnceHandle) && !Wheel.Cancel(OnceHandle),"OldHandleInvalid");
+                TEST(Wheel.IsWaiting(ReusingHandle) && !Wheel.IsWaiting(0),"NewHandleValid");
+            }
+
+            {
+                TestOutput << "Running 100 frames of 2 milliseconds on 2 threads with 2000 timers, one periodic." << endl;
+                TimerTestNow = 0;
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,2);
+                Scheduler.SetFrameLength(2000);
+                vector<TimerRecord> Records;
+                Records.reserve(2000);
+                MaxInt Now = GetTimeStamp();
+                for(Whole Count = 0; Count<1999; ++Count)
+                {
+                    MaxInt Delay = (MaxInt(Count)*7919)%150000;
+                    Records.push_back(TimerRecord(Now+Delay));
+                    Scheduler.AddTimer(RecordTimer,&Records.back(),Delay);
+                }
+                TimerRecord Periodic(Now+10000);
+                TimerHandle PeriodicHandle = Scheduler.AddTimer(RecordTimer,&Periodic,10000,10000);
+
+                for(Whole Frame = 0; Frame<100 || Scheduler.GetTimerCount()>1; ++Frame)
+                    { Scheduler.DoOneFrame(); }
+                Int32 PeriodicRuns = Periodic.Runs;
+                MaxInt Elapsed = GetTimeStamp()-Now;
+                TEST(Scheduler.CancelTimer(PeriodicHandle) && 0==Scheduler.GetTimerCount(),"SchedulerCancels");
+                Scheduler.DoOneFrame();
+                Scheduler.DoOneFrame();
+
+                Whole Early = 0, Missed = 0, Extra = 0;
+                for(Whole Count = 0; Count<Records.size(); ++Count)
+                {
+                    if(0==Records[Count].Runs)
+                        { Missed++; }
+                    else if(1<Records[Count].Runs)
+                        { Extra++; }
+                    else if(Records[Count].RanAt<Records[Count].Expected)
+                        { Early++; }
+                }
+                TestOutput << "In " << Elapsed << " microseconds " << Scheduler.GetTimerExpiryCount() << " timers expired, "
+                           << Missed << " missed, " << Extra << " extra, " << Early << " early. The periodic timer ran "
+                           << PeriodicRuns << " times." << endl;
+                TEST(0==Missed && 0==Extra && 0==Early,"SchedulerRunsEachOnce");
+                TEST(1999+PeriodicRuns==Scheduler.GetTimerExpiryCount(),"SchedulerCountsExpiries");
+                TEST(0<PeriodicRuns && PeriodicRuns<=Elapsed/10000 && Periodic.Runs==PeriodicRuns,"SchedulerPeriodic");
+            }
+
+            {
+                TestOutput << "Running frames with no pause so a timer is forked into a frame." << endl;
+                stringstream LogCache;
+                FrameScheduler Scheduler(&LogCache,2);
+                Scheduler.SetFrameLength(0);
+                TimerRecord InFrame(GetTimeStamp()+5000);
+                Scheduler.AddTimer(RecordTimer,&InFrame,5000);
+                Whole Frames = 0;
+                for(; Frames<100000 && 0==InFrame.Runs; ++Frames)
+                    { Scheduler.DoOneFrame(); }
+                TestOutput << "It ran after " << Frames << " frames." << endl;
+                TEST(1==InFrame.Runs && InFrame.RanAt>=InFrame.Expected,"ForkedIntoFrame");
+            }
+            TestOutput << endl;
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
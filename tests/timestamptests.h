@@ -84,6 +84,15 @@ class timestamptests : public UnitTestGroup
             TestOutput << "Is Timestamp1+300000-(2*TimerResolution) <= Timestamp2 = " << Timestamp1+300000-(2*GetTimeStampResolution()) << "<=" << Timestamp2 << endl;
             TestOutput << "Is Timestamp1+300000-(2*TimerResolution) <= Timestamp2: " << (MaxInt(Timestamp1+300000-(2*GetTimeStampResolution()))<=Timestamp2) << endl;
             TEST(MaxInt(Timestamp1+300000-(2*GetTimeStampResolution()))<=Timestamp2,"TimeStampResolution")
+
+            TestOutput << "Sleeping main thread until 20ms after Timestamp3." << endl;
+            Mezzanine::MaxInt Timestamp3 = Mezzanine::GetTimeStamp();
+            Mezzanine::Threading::this_thread::sleep_until(Timestamp3+20000);
+            Mezzanine::MaxInt Timestamp4 = Mezzanine::GetTimeStamp();
+            TestOutput << "Timestamp4 - Timestamp3 = " << Timestamp4-Timestamp3 << endl;
+            TEST(Timestamp3+20000<=Timestamp4,"SleepUntilDeadline")
+            Mezzanine::Threading::this_thread::sleep_until(Timestamp3);
+            TEST(Mezzanine::GetTimeStamp()<Timestamp4+20000,"SleepUntilPast")
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.
@@ -0,0 +1,156 @@
+// © Copyright 2010 - 2014 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef _workstealingdequetests_h
+#define _workstealingdequetests_h
+
+#include "mezztest.h"
+
+#include "dagframescheduler.h"
+
+/// @file
+/// @brief Tests of the Chase-Lev deque each thread keeps its ready work in.
+
+using namespace std;
+using namespace Mezzanine;
+using namespace Mezzanine::Testing;
+using namespace Mezzanine::Threading;
+
+/// @brief The deque the threads in the 'workstealingdeque' test fight over.
+WorkStealingDeque StealTestDeque;
+
+/// @brief How many times each entry was taken from StealTestDeque, each should be taken exactly once.
+vector<Int32> StealTestTaken;
+
+/// @brief How many entries the thieves have taken in total.
+Int32 StealTestStolen = 0;
+
+/// @brief Set to 1 when the owner has finished with StealTestDeque.
+Int32 StealTestOwnerDone = 0;
+
+/// @brief Steals from StealTestDeque until the owner is done and it is empty.
+void StealTestThief(void*)
+{
+    while(true)
+    {
+        Int32 Entry = StealTestDeque.Steal();
+        if(WorkStealingDeque::Empty==Entry)
+        {
+            if(AtomicAdd(&StealTestOwnerDone,0) && 0==StealTestDeque.GetSize())
+                { break; }
+            continue;
+        }
+        AtomicAdd(&StealTestTaken[Entry],1);
+        AtomicAdd(&StealTestStolen,1);
+    }
+}
+
+/// @brief Tests for the WorkStealingDeque class
+class workstealingdequetests : public UnitTestGroup
+{
+    public:
+        /// @copydoc Mezzanine::Testing::UnitTestGroup::Name
+        /// @return Returns a String containing "WorkStealingDeque"
+        virtual String Name()
+            { return String("WorkStealingDeque"); }
+
+        /// @brief Test the ordering of the ends of the deque and that concurrent stealing never duplicates or loses an entry.
+        void RunAutomaticTests()
+        {
+            TestOutput << "Pushing 1 through 5 into a deque then alternately popping and stealing." << endl;
+            WorkStealingDeque Simple;
+            TEST(!Simple.IsActive(), "StartsInactive");
+            Simple.Reset(5);
+            TEST(Simple.IsActive(), "ResetActivates");
+            for(Int32 Counter = 1; Counter<=5; ++Counter)
+                { Simple.Push(Counter); }
+            TEST(5==Simple.GetSize(), "SizeAfterPush");
+            TEST(5==Simple.Pop(), "PopTakesNewest");
+            TEST(1==Simple.Steal(), "StealTakesOldest");
+            TEST(4==Simple.Pop(), "PopTakesNewest2");
+            TEST(2==Simple.Steal(), "StealTakesOldest2");
+            TEST(3==Simple.Pop(), "PopTakesLast");
+            TEST(WorkStealingDeque::Empty==Simple.Pop(), "PopWhenEmpty");
+            TEST(WorkStealingDeque::Empty==Simple.Steal(), "StealWhenEmpty");
+            Simple.Deactivate();
+            TEST(!Simple.IsActive(), "Deactivate");
+
+            const Int32 EntryCount = 20000;
+            TestOutput << "Pushing " << EntryCount << " entries while popping some, and three other threads steal, every entry should be taken exactly once." << endl;
+            StealTestTaken.assign(EntryCount,0);
+            StealTestDeque.Reset(EntryCount);
+            Thread Thief1(StealTestThief, 0);
+            Thread Thief2(StealTestThief, 0);
+            Thread Thief3(StealTestThief, 0);
+            Int32 Popped = 0;
+            for(Int32 Counter = 0; Counter<EntryCount; ++Counter)
+            {
+                StealTestDeque.Push(Counter);
+                if(Counter%3)
+                {
+                    Int32 Entry = StealTestDeque.Pop();
+                    if(WorkStealingDeque::Empty!=Entry)
+                        { AtomicAdd(&StealTestTaken[Entry],1); Popped++; }
+                }
+            }
+            for(Int32 Entry = StealTestDeque.Pop(); WorkStealingDeque::Empty!=Entry; Entry = StealTestDeque.Pop())
+                { AtomicAdd(&StealTestTaken[Entry],1); Popped++; }
+            AtomicAdd(&StealTestOwnerDone,1);
+            Thief1.join();
+            Thief2.join();
+            Thief3.join();
+
+            Whole TakenOnce = 0;
+            for(vector<Int32>::iterator Iter = StealTestTaken.begin(); Iter!=StealTestTaken.end(); ++Iter)
+            {
+                if(1==*Iter)
+                    { TakenOnce++; }
+            }
+            TestOutput << "The owner popped " << Popped << " and thieves stole " << StealTestStolen << ", " << TakenOnce << " entries were taken exactly once." << endl;
+            TEST(Whole(EntryCount)==TakenOnce, "EachEntryTakenOnce");
+            TEST(EntryCount==Popped+StealTestStolen, "NoExtraEntries");
+        }
+
+        /// @brief Since RunAutomaticTests is implemented so is this.
+        /// @return returns true
+        virtual bool HasAutomaticTests() const
+            { return true; }
+};
+
+#endif
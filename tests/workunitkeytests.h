@@ -145,6 +145,60 @@ class workunitkeytests : public UnitTestGroup
             TestOutput << endl;
 
             delete WorkUnitK1; delete WorkUnitK2; delete WorkUnitK3; delete WorkUnitK4;
+
+            TestOutput << "A critical path overrides all other sorting when it is present:" << endl;
+            TestOutput << "\t" << "WorkUnitKey LongChain(  1, 100,  0, 9000 );" << endl;
+            TestOutput << "\t" << "WorkUnitKey ManyQuick( 10, 500,  0,  600 );" << endl;
+            WorkUnitKey LongChain(1,100,0,9000);
+            WorkUnitKey ManyQuick(10,500,0,600);
+            TEST(ManyQuick < LongChain,"ManyQuick<LongChain");
+            TEST(!(LongChain < ManyQuick),"!(LongChain<ManyQuick)");
+
+            TestOutput << "Creating a slow chain C --> B --> A and a quick fan Y1, Y2, Y3 --> X and checking which starts first." << endl;
+            FrameScheduler PathScheduler(&TestOutput,1);
+            PiMakerWorkUnit* WorkUnitA = new PiMakerWorkUnit(50,"A",false);
+            PiMakerWorkUnit* WorkUnitB = new PiMakerWorkUnit(50,"B",false);
+            PiMakerWorkUnit* WorkUnitC = new PiMakerWorkUnit(50,"C",false);
+            PiMakerWorkUnit* WorkUnitX = new PiMakerWorkUnit(50,"X",false);
+            PiMakerWorkUnit* WorkUnitY1 = new PiMakerWorkUnit(50,"Y1",false);
+            PiMakerWorkUnit* WorkUnitY2 = new PiMakerWorkUnit(50,"Y2",false);
+            PiMakerWorkUnit* WorkUnitY3 = new PiMakerWorkUnit(50,"Y3",false);
+            WorkUnitB->AddDependency(WorkUnitA);
+            WorkUnitC->AddDependency(WorkUnitB);
+            WorkUnitY1->AddDependency(WorkUnitX);
+            WorkUnitY2->AddDependency(WorkUnitX);
+            WorkUnitY3->AddDependency(WorkUnitX);
+            for(Whole Counter=0; Counter<MEZZ_FRAMESTOTRACK; ++Counter)
+            {
+                WorkUnitA->GetPerformanceLog().Insert(5000);
+                WorkUnitB->GetPerformanceLog().Insert(5000);
+                WorkUnitC->GetPerformanceLog().Insert(5000);
+                WorkUnitX->GetPerformanceLog().Insert(10);
+                WorkUnitY1->GetPerformanceLog().Insert(10);
+                WorkUnitY2->GetPerformanceLog().Insert(10);
+                WorkUnitY3->GetPerformanceLog().Insert(10);
+            }
+            PathScheduler.AddWorkUnitMain(WorkUnitA, WorkUnitA->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitB, WorkUnitB->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitC, WorkUnitC->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitX, WorkUnitX->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitY1, WorkUnitY1->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitY2, WorkUnitY2->Name);
+            PathScheduler.AddWorkUnitMain(WorkUnitY3, WorkUnitY3->Name);
+
+            TEST(!PathScheduler.GetCriticalPathSorting(),"CriticalPathSortingDefaultsOff");
+            PathScheduler.SortWorkUnitsMain();
+            TEST(PathScheduler.GetNextWorkUnit()==WorkUnitX,"DependentCountPicksX");
+
+            PathScheduler.SetCriticalPathSorting(true);
+            PathScheduler.SortWorkUnitsMain();
+            TestOutput << dec << "A critical path: " << PathScheduler.GetCriticalPathOf(WorkUnitA)
+                       << " \t X critical path: " << PathScheduler.GetCriticalPathOf(WorkUnitX) << endl;
+            TEST(PathScheduler.GetCriticalPathOf(WorkUnitA)==WorkUnitA->GetPerformance()+WorkUnitB->GetPerformance()+WorkUnitC->GetPerformance(),"ACriticalPath");
+            TEST(PathScheduler.GetCriticalPathOf(WorkUnitX)==WorkUnitX->GetPerformance()+WorkUnitY1->GetPerformance(),"XCriticalPath");
+            TEST(PathScheduler.GetCriticalPathOf(WorkUnitC)==WorkUnitC->GetPerformance(),"CCriticalPath");
+            TEST(PathScheduler.GetNextWorkUnit()==WorkUnitA,"CriticalPathPicksA");
+            TEST(PathScheduler.GetNextWorkUnit()==WorkUnitX,"CriticalPathThenX");
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.
@@ -122,6 +122,11 @@ class PiMakerWorkUnit : public Mezzanine::Threading::DefaultWorkUnit
         }
 };
 
+/// @brief Used as a thread that waits for every WorkUnit in a frame to complete.
+/// @param Scheduler A pointer to the FrameScheduler to wait on.
+void WaitForAllWorkUnitsOn(void* Scheduler)
+    { ((FrameScheduler*)Scheduler)->WaitForAllWorkUnits(); }
+
 /// @brief Tests for the WorkUnit class
 class workunittests : public UnitTestGroup
 {
@@ -190,6 +195,106 @@ class workunittests : public UnitTestGroup
             TEST(WorkUnitC->GetDependentCount(TestScheduler)==0,"C2DependentCount");
             TEST(WorkUnitD->GetDependencyCount()==2,"D2DependencyCount");
             TEST(WorkUnitD->GetDependentCount(TestScheduler)==0,"D2DependentCount");
+
+            TestOutput << "Sorting the scheduler and checking how many dependencies each WorkUnit is waiting on this frame." << endl;
+            TestScheduler.SortWorkUnitsMain();
+            TestOutput << "A remaining: " << WorkUnitA->GetRemainingDependencyCount() << " \t B remaining: " << WorkUnitB->GetRemainingDependencyCount()
+                 << " \t C remaining: " << WorkUnitC->GetRemainingDependencyCount() << " \t D remaining: " << WorkUnitD->GetRemainingDependencyCount() << endl;
+            TEST(WorkUnitA->GetRemainingDependencyCount()==0,"ARemainingDependencies");
+            TEST(WorkUnitB->GetRemainingDependencyCount()==1,"BRemainingDependencies");
+            TEST(WorkUnitC->GetRemainingDependencyCount()==1,"CRemainingDependencies");
+            TEST(WorkUnitD->GetRemainingDependencyCount()==1,"DRemainingDependencies");
+            TEST(TestScheduler.GetNextWorkUnit()==WorkUnitA,"OnlyAReady");
+            TEST(TestScheduler.GetNextWorkUnit()==0,"NothingElseReady");
+            (*WorkUnitA)(TestThreadStorage);
+            TEST(WorkUnitB->GetRemainingDependencyCount()==0,"BReleasedByA");
+            TEST(TestScheduler.GetNextWorkUnit()==WorkUnitB,"BReadyAfterA");
+
+            TestOutput << "Checking the count of outstanding WorkUnits as the rest of the frame is run." << endl;
+            TEST(TestScheduler.GetOutstandingWorkUnitCount()==3,"ThreeOutstandingAfterA");
+            TEST(TestScheduler.WaitForWorkUnitCompletion(4)==3,"WaitReturnsOnceCountChanged");
+            TEST(!TestScheduler.AreAllWorkUnitsComplete(),"NotCompleteAfterA");
+
+            TestOutput << "Parking a thread waiting on the rest of the frame and waking it by completing the work." << endl;
+            TestScheduler.SetIdleSpinCount(0);
+            TestScheduler.SetIdleYieldCount(0);
+            TEST(TestScheduler.GetIdleSpinCount()==0 && TestScheduler.GetIdleYieldCount()==0,"IdleThresholdsSet");
+            Int32 ParksBefore = TestScheduler.GetIdleParkCount();
+            Thread Waiter(WaitForAllWorkUnitsOn,&TestScheduler);
+            for(Whole Tries = 0; Tries<1000 && ParksBefore==TestScheduler.GetIdleParkCount(); ++Tries)
+                { this_thread::sleep_for(1000); }
+            TEST(ParksBefore<TestScheduler.GetIdleParkCount(),"WaitingThreadParks");
+            (*WorkUnitB)(TestThreadStorage);
+            (*WorkUnitC)(TestThreadStorage);
+            (*WorkUnitD)(TestThreadStorage);
+            Waiter.join(); // Would never return if the last completion did not wake the parked thread
+            TestScheduler.SetIdleSpinCount(256);
+            TestScheduler.SetIdleYieldCount(8);
+            TEST(TestScheduler.GetOutstandingWorkUnitCount()==0,"NoneOutstanding");
+            TEST(TestScheduler.AreAllWorkUnitsComplete(),"CompleteWhenNoneOutstanding");
+            TestScheduler.WaitForAllWorkUnits(); // Would never return if the count were wrong
+            TestScheduler.ResetAllWorkUnits();
+            TEST(TestScheduler.GetOutstandingWorkUnitCount()==4,"AllOutstandingAfterReset");
+            TEST(WorkUnitB->GetRemainingDependencyCount()==1,"BCountRestoredAfterReset");
+            TEST(TestScheduler.GetNextWorkUnit()==WorkUnitA,"OnlyAReadyAfterReset");
+
+            TestOutput << "Tying a WorkUnit to a frame epoch, and checking that advancing the epoch resets it." << endl;
+            Whole Epoch = 5;
+            PiMakerWorkUnit EpochUnit(50,"Epoch",false);
+            TEST(EpochUnit.UseFrameEpoch(&Epoch),"DefaultWorkUnitUsesEpoch");
+            EpochUnit(TestThreadStorage);
+            TEST(EpochUnit.GetRunningState()==Complete,"CompleteWithinEpoch");
+            Epoch++;
+            TEST(EpochUnit.GetRunningState()==NotStarted,"NotStartedAfterEpochAdvances");
+            TEST(EpochUnit.TakeOwnerShip()==Starting,"StartableAfterEpochAdvances");
+            TEST(EpochUnit.GetRunningState()==Running,"RunningWithinEpoch");
+            EpochUnit.UseFrameEpoch(0);
+            TEST(EpochUnit.GetRunningState()==Running,"StateKeptWhenLeavingEpoch");
+
+            TestOutput << "Checking that a WorkUnit no scheduler has counted still waits for its dependencies." << endl;
+            PiMakerWorkUnit Uncounted(50,"Uncounted",false);
+            PiMakerWorkUnit UncountedDependency(50,"UncountedDependency",false);
+            Uncounted.AddDependency(&UncountedDependency);
+            TEST(Uncounted.TakeOwnerShip()==NotStarted,"UncountedWaitsForDependency");
+            UncountedDependency(TestThreadStorage);
+            TEST(Uncounted.TakeOwnerShip()==Starting,"UncountedStartsAfterDependency");
+
+            TestOutput << "Creating a ladder of 24 diamonds, each pair of WorkUnits depends on both WorkUnits of the pair before it."
+                 << endl << "Counting every chain through this without the scheduler's memoized counts would take tens of millions of steps." << endl;
+            FrameScheduler LadderScheduler(&TestOutput,1);
+            const Whole LadderHeight = 24;
+            std::vector<PiMakerWorkUnit*> Left;
+            std::vector<PiMakerWorkUnit*> Right;
+            for(Whole Rung=0; Rung<LadderHeight; ++Rung)
+            {
+                Left.push_back(new PiMakerWorkUnit(50,"Left",false));
+                Right.push_back(new PiMakerWorkUnit(50,"Right",false));
+                if(Rung)
+                {
+                    Left[Rung]->AddDependency(Left[Rung-1]);
+                    Left[Rung]->AddDependency(Right[Rung-1]);
+                    Right[Rung]->AddDependency(Left[Rung-1]);
+                    Right[Rung]->AddDependency(Right[Rung-1]);
+                }
+                LadderScheduler.AddWorkUnitMain(Left[Rung], "Left");
+                LadderScheduler.AddWorkUnitMain(Right[Rung], "Right");
+            }
+            LadderScheduler.UpdateDependentGraph();
+            // Each rung counts both WorkUnits below it and everything they count: 2*(1+Previous) = 2^(Rung+1)-2
+            Whole Expected = (Whole(1)<<LadderHeight)-2;
+            TestOutput << dec << "Top dependency count: " << LadderScheduler.GetDependencyCountOf(Left[LadderHeight-1]) << " \t Bottom dependent count: "
+                 << LadderScheduler.GetDependentCountOf(Left[0]) << " \t Expected: " << Expected << endl;
+            TEST(LadderScheduler.GetDependencyCountOf(Left[LadderHeight-1])==Expected,"LadderDependencyCount");
+            TEST(LadderScheduler.GetDependentCountOf(Right[0])==Expected,"LadderDependentCount");
+            TEST(LadderScheduler.GetDependencyCountOf(Left[1])==2,"LadderSecondRungDependencyCount");
+
+            TestOutput << "Removing a dependency from the second rung, the cached counts should follow." << endl;
+            Left[1]->RemoveDependency(Right[0]);
+            LadderScheduler.UpdateDependentGraph();
+            TEST(LadderScheduler.GetDependencyCountOf(Left[1])==1,"LadderRemovedDependencyCount");
+            TEST(LadderScheduler.GetDependencyCountOf(Left[2])==5,"LadderRemovedDependencyCountAbove");
+            TEST(Left[2]->GetDependencyCount()==5,"LadderWorkUnitDependencyCount");
+            TEST(LadderScheduler.GetDependentCountOf(Right[0])==Expected/2,"LadderRemovedDependentCount");
         }
 
         /// @brief Since RunAutomaticTests is implemented so is this.